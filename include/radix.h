@@ -8,8 +8,17 @@
 typedef enum RadixError {
     RADIX_SUCCESS,
     RADIX_OUT_OF_MEMORY,
+    RADIX_INVALID_ARGUMENT,
 } RadixError;
 
+/**
+ * Radix Clock
+ *  This function returns the current time (in any non-decreasing unit,
+ *  e.g. nanoseconds) for the time index.
+ *  @see RadixOptions
+ */
+typedef uint64_t (*RadixClock)(void *context);
+
 /**
  * Radix
  *  This structure provides information about the resources of radix.
@@ -27,8 +36,178 @@ typedef enum RadixError {
 typedef struct Radix {
     unsigned char *memory;
     size_t memorySize;
+
+    unsigned char *valueLog;
+    size_t valueLogSize;
+
+    // Clock belongs to the process, so it is not stored in the structure memory
+    RadixClock clock;
+    void *clockContext;
 } Radix;
 
+/**
+ * Radix Options
+ *  This structure provides information about optional features of radix,
+ *  they are stored in the structure memory when it is cleared.
+ *  @see radixClearOptions
+ *
+ *  Zeroed options disable all features.
+ */
+typedef struct RadixOptions {
+    // Number of exact-match hash index slots, rounded up to the power of two
+    // (0 - disabled). The index keeps a copy of each key, so exact matches
+    // starting from the head-node cost a hash lookup and one key comparison.
+    // Index gets full at 3/4 of the slots, then the missing keys are
+    // looked up in the tree.
+    size_t indexSlots;
+
+    // Number of bloom filter bits, rounded up to the whole 512-bit blocks
+    // (0 - disabled). Exact matches starting from the head-node of the
+    // missing keys are rejected by reading one cache line of the filter.
+    // Keys restored by the checkpoint stay in the filter until rebuilt.
+    size_t filterBits;
+
+    // Minimal size of values stored in the value log (0 - disabled).
+    // Large values are appended to the separate memory, so the structure
+    // memory holds only nodes, items and small values.
+    // @see radixCreateValueLog
+    size_t valueThreshold;
+
+    // Number of data deduplication slots, rounded up to the power of two
+    // (0 - disabled). Data identical to the data of an older item is shared
+    // with it instead of being copied (values stored in the structure memory only).
+    // Table gets full at 3/4 of the slots, then new data is just not shared.
+    size_t dedupSlots;
+
+    // Minimal size of compressed values (0 - disabled). Values stored
+    // in the structure memory are compressed if it makes them smaller,
+    // their data pointer is NULL and they are read by radixValueRead.
+    size_t compressThreshold;
+
+    // Number of key fragment slots, rounded up to the power of two
+    // (0 - disabled). Nodes with the same key fragment (edge label)
+    // share one copy of its bytes, e.g. repeated key suffixes in different
+    // subtrees. Table gets full at 3/4 of the slots.
+    size_t fragmentSlots;
+
+    // Whether nodes are aligned, so they never straddle two cache lines
+    // and each step of the descent reads one line. Lines are counted from
+    // the start of the memory, so the memory must be aligned to the cache
+    // line (64 bytes, otherwise RADIX_INVALID_ARGUMENT). Padding costs
+    // less than one node per node - up to 63 bytes, since the default
+    // 64-byte node fills a whole line and is padded unless it starts one
+    // (the compact 32-byte node is padded by at most 31 bytes).
+    bool alignNodes;
+
+    // Whether items store their version number of the key and the skip
+    // pointer (two offsets per item), so the value of the key as of
+    // a version or a checkpoint is found in O(log versions).
+    bool versions;
+
+    // Number of expiry heap entries (0 - disabled). Items store their expiry
+    // time (of the clock), expired values are treated as null data by
+    // non-nullable functions and radixExpireStep shadows them in the expiry
+    // order. Heap gets full at its size, then values still expire on reads.
+    size_t expirySlots;
+
+    // Number of time index entries (0 - disabled). Every timeStride-th
+    // item is indexed with its time, so the chronological position of
+    // a checkpoint or a time is found by the binary search and a walk
+    // of less than the stride items. Full index keeps every other entry
+    // and doubles the stride (0 stride - every item is indexed).
+    size_t timeSlots;
+    size_t timeStride;
+
+    // Memory budget of the cache mode (0 - disabled). Nodes and items are
+    // stored in power-of-two blocks, replaced and removed keys release them
+    // and inserts into the full budget evict keys not matched since the last
+    // pass of the CLOCK hand (at most 16 keys per insert). Cache mode keeps
+    // no history and works without the other options (except the clock).
+    size_t cacheMemory;
+
+    // Clock of the time index and expiry (NULL - time is zero). It is set
+    // to the radix object, not stored in the structure memory (the memory
+    // can be mapped or imported by other processes).
+    // @see radixSetClock
+    RadixClock clock;
+    void *clockContext;
+} RadixOptions;
+
+/**
+ * Radix Filter Stats
+ *  This structure provides information about the bloom filter.
+ *
+ *  @see radixFilterStats
+ */
+typedef struct RadixFilterStats {
+    size_t bits;
+    size_t bitsSet;
+    size_t keys;
+
+    // Estimated probability that the missing key is not rejected
+    double falsePositiveRate;
+} RadixFilterStats;
+
+// Number of depth histogram buckets (deeper keys are counted in the last one)
+#define RADIX_STATS_DEPTHS 64
+
+/**
+ * Radix Stats
+ *  This structure provides information about the structure contents.
+ *
+ *  Depth fields are filled only by the full walk.
+ *
+ *  @see radixStats
+ */
+typedef struct RadixStats {
+    // Number of nodes (including the head-node) and of nodes without items (created by splits)
+    size_t nodes;
+    size_t splitNodes;
+    double splitRatio;
+
+    // Number of items - all versions, visible values, older (shadowed) versions
+    // and visible null data (removed keys)
+    size_t items;
+    size_t liveItems;
+    size_t shadowedItems;
+    size_t nullItems;
+
+    // Key fragment bytes stored by nodes (shared fragments are counted once)
+    size_t keyBytes;
+
+    // Data bytes of all items (before compression)
+    size_t valueBytes;
+
+    // Memory of shadowed items and null data items (reclaimed by compaction)
+    size_t deadBytes;
+
+    // Number of keys evicted by the cache mode
+    size_t evictions;
+
+    // Depths (number of nodes from the head-node) of visible values
+    size_t maxDepth;
+    double averageDepth;
+    size_t depths[RADIX_STATS_DEPTHS];
+} RadixStats;
+
+/**
+ * Radix Counters
+ *  This structure provides the work done by the calling thread.
+ *  Counters are collected only by builds with RADIX_STATS defined.
+ *
+ *  @see radixCounters
+ */
+typedef struct RadixCounters {
+    // Nodes whose key was compared by descents or which were visited by iterations
+    size_t nodesVisited;
+
+    // Key bits compared by descents
+    size_t bitsCompared;
+
+    // Null data items skipped by non-nullable iterations (radixNext, radixEarlier, ...)
+    size_t nullItemsSkipped;
+} RadixCounters;
+
 /**
  * Radix Value Iterator
  *  This structure provides information about radix value
@@ -105,6 +284,161 @@ typedef struct RadixCheckpoint {
     size_t state;
 } RadixCheckpoint;
 
+/**
+ * Radix Finger
+ *  This structure remembers the position of the last operation (node and
+ *  copy of its key), so the next operation with a nearby key resumes from
+ *  their deepest common ancestor instead of the head-node.
+ *
+ *  Readonly!
+ *
+ *  Remember that fingers after restoring the checkpoint will not work properly.
+ *
+ *  @see radixFinger
+ *  @see radixFingerInsert
+ *  @see radixFingerMatch
+ */
+typedef struct RadixFinger {
+    RadixIterator iterator;
+
+    unsigned char *key;
+    size_t keyBits;
+    size_t keyMemorySize;
+} RadixFinger;
+
+/**
+ * Radix Shards
+ *  This structure provides information about the radix shards.
+ *
+ *  Readonly!
+ *
+ *  Keys are routed to shards by their leading shardBits bits, every shard
+ *  is an independent radix with its own memory, so each shard can have its
+ *  own writer (or lock) and writes to different shards can run in parallel.
+ *  @see radixShardsCreate
+ */
+typedef struct RadixShards {
+    Radix *shards;
+    size_t shardBits;
+} RadixShards;
+
+/**
+ * Radix Release Callback
+ *  This function is called with the referenced data when the item
+ *  referencing it is discarded by the checkpoint restore.
+ *  @see radixInsertReference
+ */
+typedef void (*RadixReleaseCallback)(void *context, unsigned char *data, size_t dataSize);
+
+/**
+ * Radix Batch Callback
+ *  This function is called for each applied batch entry with the value
+ *  created by its insert (empty value if the batch could not be applied).
+ *  @see radixBatchApply
+ */
+typedef void (*RadixBatchCallback)(void *context, RadixValue *value);
+
+/**
+ * Radix Batch Entry
+ *  This structure provides information about the queued insert.
+ *
+ *  Readonly!
+ *
+ *  @see radixBatchPush
+ */
+typedef struct RadixBatchEntry {
+    unsigned char *key;
+    size_t keyBits;
+
+    unsigned char *data;
+    size_t dataSize;
+
+    RadixBatchCallback callback;
+    void *context;
+
+    size_t sequence;
+    RadixValue value;
+
+    // Accessed atomically by the library only
+    size_t turn;
+} RadixBatchEntry;
+
+/**
+ * Radix Batch
+ *  This structure provides information about the bounded queue of inserts
+ *  waiting to be applied by the writer in one batch.
+ *
+ *  Readonly!
+ *
+ *  Producers only queue the inserts, the tree is modified by the writer,
+ *  so the tree maintenance is moved off the producers path. The queue is
+ *  a lock-free ring - producers claim the tail, the writer takes
+ *  the published entries from the head.
+ *  @see radixBatchCreate
+ *  @see radixBatchPush
+ *  @see radixBatchApply
+ */
+typedef struct RadixBatch {
+    RadixBatchEntry *entries;
+    size_t capacity;
+
+    // Accessed atomically by the library only
+    size_t tail;
+    size_t head;
+
+    RadixCheckpoint checkpoint;
+} RadixBatch;
+
+/**
+ * Radix Stream Write
+ *  This function writes the next bytes of the stream (e.g. to a file or a socket).
+ *  @see radixStreamExport
+ *
+ *  @return true if all bytes were written
+ */
+typedef bool (*RadixStreamWrite)(void *context, unsigned char *data, size_t size);
+
+/**
+ * Radix Stream Read
+ *  This function reads the next bytes of the stream into the data memory.
+ *  @see radixStreamImport
+ *
+ *  @return number of bytes read (0 at the end of the stream)
+ */
+typedef size_t (*RadixStreamRead)(void *context, unsigned char *data, size_t size);
+
+/**
+ * Radix Numa Policy
+ *  This enumeration selects the NUMA placement of the mapped memory.
+ *  @see radixCreateMapped
+ */
+typedef enum RadixNumaPolicy {
+    // Pages are placed on the node of the thread touching them first
+    RADIX_NUMA_DEFAULT,
+
+    // Pages are interleaved over all allowed nodes
+    RADIX_NUMA_INTERLEAVE,
+
+    // Pages are placed on the given node
+    RADIX_NUMA_BIND,
+} RadixNumaPolicy;
+
+/**
+ * Radix Memory Options
+ *  This structure provides information about the mapped memory.
+ *  @see radixCreateMapped
+ *
+ *  Options are hints, memory is mapped even if the system does not support them.
+ */
+typedef struct RadixMemoryOptions {
+    // Whether huge pages are used (reserved huge pages or transparent huge pages),
+    // so random descents through large structures miss the TLB less often
+    bool hugePages;
+
+    RadixNumaPolicy numaPolicy;
+    size_t numaNode;
+} RadixMemoryOptions;
+
 /**
  * Radix Create
  *  This function creates a radix tree object.
@@ -114,6 +448,82 @@ typedef struct RadixCheckpoint {
  */
 Radix radixCreate(unsigned char *memory, size_t memorySize);
 
+/**
+ * Radix Create Value Log
+ *  This function creates a radix tree object with the value log - append-only
+ *  memory for large values (enabled by the valueThreshold option).
+ *  @see radixCreate
+ *  @see radixClearOptions
+ *
+ *  @param memory pointer to allocated memory
+ *  @param memorySize memory size (in bytes)
+ *  @param valueLog pointer to allocated value log memory
+ *  @param valueLogSize value log memory size (in bytes)
+ *  @return Radix object
+ */
+Radix radixCreateValueLog(unsigned char *memory, size_t memorySize, unsigned char *valueLog, size_t valueLogSize);
+
+/**
+ * Radix Set Clock
+ *  This function sets the clock of the time index and expiry
+ *  to the radix object, e.g. after the memory of the existing structure
+ *  was mapped or imported (radixClearOptions sets the clock of the options).
+ *
+ *  Operations read the clock once, so all items visited by one
+ *  operation are checked against the same time.
+ *
+ *  @param radix radix tree
+ *  @param clock clock (NULL - time is zero)
+ *  @param clockContext clock context
+ */
+void radixSetClock(Radix *radix, RadixClock clock, void *clockContext);
+
+/**
+ * Radix Create Mapped
+ *  This function maps the memory (filled with zeros) and creates a radix tree object.
+ *  @see radixCreate
+ *
+ *  Memory size can be rounded up (e.g. to huge pages).
+ *  Memory of the returned object is NULL if the memory could not be mapped.
+ *
+ *  @param memorySize memory size (in bytes)
+ *  @param options memory options (can be NULL)
+ *  @return Radix object
+ */
+Radix radixCreateMapped(size_t memorySize, RadixMemoryOptions *options);
+
+/**
+ * Radix Destroy Mapped
+ *  This function unmaps the memory of the radix created by radixCreateMapped
+ *  or radixCreateReplica.
+ *
+ *  @param radix radix tree
+ */
+void radixDestroyMapped(Radix *radix);
+
+/**
+ * Radix Numa Nodes
+ *  This function returns the number of NUMA nodes (1 if NUMA is not supported),
+ *  e.g. to create the replica for each node.
+ *
+ *  @return number of NUMA nodes
+ */
+size_t radixNumaNodes(void);
+
+/**
+ * Radix Create Replica
+ *  This function maps the memory and copies the structure to it,
+ *  e.g. to let the readers of read-mostly structure use the memory
+ *  of their NUMA node (RADIX_NUMA_BIND). The value log is shared.
+ *
+ *  Memory of the returned object is NULL if the memory could not be mapped.
+ *
+ *  @param radix radix tree
+ *  @param options memory options (can be NULL)
+ *  @return Radix object
+ */
+Radix radixCreateReplica(Radix *radix, RadixMemoryOptions *options);
+
 /**
  * Radix Iterator
  *  This function creates a radix tree iterator.
@@ -144,6 +554,9 @@ RadixValue radixValueIterator(Radix *radix);
  *  given iterator. If there is already a data with the given key, it is
  *  shadowing with the new one.
  *
+ *  In the cache mode, the data replaces the older one and the full memory
+ *  budget evicts other keys, so their iterators must not be used anymore.
+ *
  *  @param iterator radix tree iterator
  *  @param key pointer to key
  *  @param keyBits key size (in bits)
@@ -153,11 +566,71 @@ RadixValue radixValueIterator(Radix *radix);
  */
 RadixValue radixInsert(RadixIterator* iterator, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize);
 
+/**
+ * Radix Insert Reference
+ *  This function inserts the reference to caller-owned data under the given
+ *  key relative to the given iterator. The data is not copied, values read
+ *  from the structure point directly to it.
+ *  @see radixInsert
+ *
+ *  The data must stay valid until the release callback is called
+ *  (when the item is discarded by the checkpoint restore).
+ *  To release all references, restore the checkpoint taken right after clearing.
+ *  @see radixCheckpointRestore
+ *
+ *  @param iterator radix tree iterator
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @param data pointer to referenced data
+ *  @param dataSize data size (in bytes)
+ *  @param release release callback (can be NULL)
+ *  @param context release callback context
+ *  @return RadixValue object
+ */
+RadixValue radixInsertReference(RadixIterator* iterator, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize, RadixReleaseCallback release, void *context);
+
+/**
+ * Radix Insert Expiring
+ *  This function inserts the value that expires at the given time of the clock.
+ *  Expired value is treated as null data by non-nullable functions
+ *  (nullable functions return it as it is, like the shadowed values).
+ *  @see radixExpireStep
+ *
+ *  Expiry requires the expirySlots option and the clock,
+ *  otherwise the value never expires.
+ *
+ *  @param iterator radix tree iterator
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @param data pointer to data
+ *  @param dataSize data size (in bytes)
+ *  @param expires expiry time of the clock (0 - never)
+ *  @return RadixValue object
+ */
+RadixValue radixInsertExpiring(RadixIterator* iterator, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize, uint64_t expires);
+
+/**
+ * Radix Expire Step
+ *  This function shadows expired values by null data (like radixRemove)
+ *  in the order of expiry, e.g. called periodically to bound the memory
+ *  and stats of expired keys without full scans.
+ *
+ *  Each step pops at most budget entries of the expiry heap
+ *  (O(log entries) each), values replaced by newer values are skipped.
+ *
+ *  @param radix radix tree
+ *  @param budget maximal number of heap entries to process
+ *  @return number of expired keys
+ */
+size_t radixExpireStep(Radix *radix, size_t budget);
+
 /**
  * Radix Record Remove
  *  This function does not actually delete the record.
  *  Inserts new null data for this key.
  *
+ *  In the cache mode, the record is deleted and the result is empty.
+ *
  *  @param iterator radix tree iterator
  *  @param key pointer to key
  *  @param keyBits key size (in bits)
@@ -494,6 +967,60 @@ RadixValue radixValuePrevious(RadixValue *iterator);
  */
 RadixValue radixValuePreviousNullable(RadixValue *iterator);
 
+/**
+ * Radix Value Version
+ *  This function returns the version number of the value within its key
+ *  (the first value of the key is 1).
+ *
+ *  @param iterator radix value iterator
+ *  @return version number (0 if versions are disabled or the iterator is empty)
+ */
+size_t radixValueVersion(RadixValue *iterator);
+
+/**
+ * Radix Value At Version
+ *  This function returns a iterator pointing to the value of the same key
+ *  with the given version number (not greater than the version of the given value).
+ *  returns even if the value is null.
+ *
+ *  Versions are reached by O(log versions) skip pointer jumps.
+ *
+ *  @param iterator radix value iterator
+ *  @param version version number
+ *  @return RadixValue object (empty if versions are disabled)
+ */
+RadixValue radixValueAtVersion(RadixValue *iterator, size_t version);
+
+/**
+ * Radix Value As Of
+ *  This function returns a iterator pointing to the value of the same key
+ *  visible at the checkpoint (the latest value inserted before it,
+ *  not later than the given value).
+ *  returns only an iterator with non-null data (empty if the key was removed).
+ *
+ *  With versions enabled the value is reached by O(log versions) skip pointer
+ *  jumps, otherwise previous values are walked one by one.
+ *
+ *  @param iterator radix value iterator
+ *  @param checkpoint checkpoint object
+ *  @return RadixValue object
+ */
+RadixValue radixValueAsOf(RadixValue *iterator, RadixCheckpoint *checkpoint);
+
+/**
+ * Radix Value As Of
+ *  This function returns a iterator pointing to the value of the same key
+ *  visible at the checkpoint.
+ *  returns even if the value is null.
+ *
+ *  @see radixValueAsOf
+ *
+ *  @param iterator radix value iterator
+ *  @param checkpoint checkpoint object
+ *  @return RadixValue object
+ */
+RadixValue radixValueAsOfNullable(RadixValue *iterator, RadixCheckpoint *checkpoint);
+
 /**
  * Radix Value Earlier (chronological order)
  *  This function will return an iterator pointing to the earlier element.
@@ -502,9 +1029,6 @@ RadixValue radixValuePreviousNullable(RadixValue *iterator);
  *  Passing an empty value iterator returns an value iterator
  *  pointing to the latest element.
  *
- *  There is no radixValueLater function because it would require increasing
- *  memory usage.
- *
  *  @param iterator radix value iterator
  *  @return radix value iterator object
  */
@@ -518,14 +1042,68 @@ RadixValue radixValueEarlier(RadixValue *iterator);
  *  Passing an empty value iterator returns an value iterator
  *  pointing to the latest element.
  *
- *  There is no radixValueLaterNullable function because it would require
- *  increasing memory usage.
- *
  *  @param iterator radix value iterator
  *  @return radix value iterator object
  */
 RadixValue radixValueEarlierNullable(RadixValue *iterator);
 
+/**
+ * Radix Value Later (chronological order)
+ *  This function will return an iterator pointing to the later element.
+ *  returns only an iterator with non-null data.
+ *
+ *  Passing an empty value iterator returns an value iterator
+ *  pointing to the earliest element.
+ *
+ *  Items store only the earlier item, so the later item is found by the walk
+ *  back from the following time index entry (from the latest item without it).
+ *
+ *  @param iterator radix value iterator
+ *  @return radix value iterator object
+ */
+RadixValue radixValueLater(RadixValue *iterator);
+
+/**
+ * Radix Value Later (chronological order)
+ *  This function will return an value iterator pointing to the later element.
+ *  returns even if the value is null.
+ *
+ *  @see radixValueLater
+ *
+ *  @param iterator radix value iterator
+ *  @return radix value iterator object
+ */
+RadixValue radixValueLaterNullable(RadixValue *iterator);
+
+/**
+ * Radix Value Seek (chronological order)
+ *  This function will return an iterator pointing to the latest element
+ *  inserted before the checkpoint, e.g. to replay history from it by radixValueLater.
+ *  returns only an iterator with non-null data.
+ *
+ *  Cost is the binary search of the time index and a walk of less than
+ *  the stride items (without the index - walk from the latest item).
+ *
+ *  @param radix radix tree
+ *  @param checkpoint checkpoint object
+ *  @return radix value iterator object
+ */
+RadixValue radixValueSeek(Radix *radix, RadixCheckpoint *checkpoint);
+
+/**
+ * Radix Value Seek (chronological order)
+ *  This function will return an value iterator pointing to the latest element
+ *  inserted before the checkpoint.
+ *  returns even if the value is null.
+ *
+ *  @see radixValueSeek
+ *
+ *  @param radix radix tree
+ *  @param checkpoint checkpoint object
+ *  @return radix value iterator object
+ */
+RadixValue radixValueSeekNullable(Radix *radix, RadixCheckpoint *checkpoint);
+
 /**
  * Radix Iterator To Value
  *  This function converts value to iterator.
@@ -556,6 +1134,18 @@ RadixCheckpoint radixValueToCheckpoint(RadixValue *iterator);
  */
 bool radixValueIsEmpty(RadixValue *iterator);
 
+/**
+ * Radix Value Read
+ *  This function copies the data of the value to the given output,
+ *  compressed data is decompressed (its value data pointer is NULL).
+ *
+ *  @param iterator radix value iterator object
+ *  @param output pointer to output memory
+ *  @param outputSize output memory size (in bytes), at least the value data size
+ *  @return success or specific error
+ */
+RadixError radixValueRead(RadixValue *iterator, unsigned char *output, size_t outputSize);
+
 /**
  * Radix Key Bits
  *  This function returns the number of key bits.
@@ -593,6 +1183,21 @@ RadixError radixKeyCopy(RadixIterator *iterator, unsigned char *outputKey, size_
  */
 RadixCheckpoint radixCheckpoint(Radix *radix);
 
+/**
+ * Radix Time Checkpoint
+ *  This function returns the checkpoint of the latest indexed item
+ *  with time not greater than the given time (e.g. for radixValueSeek).
+ *
+ *  Times of items between index entries are not known, so items inserted
+ *  before the time but after the indexed item (less than the stride)
+ *  are after the checkpoint.
+ *
+ *  @param radix radix tree
+ *  @param time time of the clock
+ *  @return checkpoint object (current state if the time index is disabled)
+ */
+RadixCheckpoint radixTimeCheckpoint(Radix *radix, uint64_t time);
+
 /**
  * Radix Checkpoint Restore
  *  This function undoes changes to the structure that occurred between
@@ -601,6 +1206,8 @@ RadixCheckpoint radixCheckpoint(Radix *radix);
  *  Remember that iterators and checkpoints created
  *  after the checkpoint will not work properly.
  *
+ *  Structure in the cache mode is not restored.
+ *
  *  @param radix radix tree
  *  @param checkpoint radix checkpoint
  *  @return void - the function may fail, but it will never report it
@@ -623,14 +1230,569 @@ void radixCheckpointRestore(Radix *radix, RadixCheckpoint *checkpoint);
  */
 RadixError radixClear(Radix *radix);
 
+/**
+ * Radix Clear Options
+ *  This function clears the contents of the structure and enables
+ *  the given optional features.
+ *  @see radixClear
+ *
+ *  Remember that iterators and checkpoints after that will not work properly.
+ *
+ *  @param radix radix tree
+ *  @param options radix options
+ *  @return success or specific error
+ */
+RadixError radixClearOptions(Radix *radix, RadixOptions *options);
+
+/**
+ * Radix Filter Rebuild
+ *  This function rebuilds the bloom filter from the keys currently in the
+ *  structure, e.g. after restoring the checkpoint.
+ *
+ *  Keys are copied to the free memory of the structure while rebuilding.
+ *
+ *  @param radix radix tree
+ *  @return success or specific error
+ */
+RadixError radixFilterRebuild(Radix *radix);
+
+/**
+ * Radix Filter Stats
+ *  This function returns the bloom filter statistics.
+ *  Its cost is proportional to the filter size.
+ *
+ *  @param radix radix tree
+ *  @return RadixFilterStats object (zeroed if the filter is disabled)
+ */
+RadixFilterStats radixFilterStats(Radix *radix);
+
 /**
  * Radix Memory Usage
  *  This function returns the size of structure memory in use.
- *  e.g. for serialization to a file.
+ *  Portable images (e.g. for files) are written by radixExport.
  *
  *  @param radix radix tree
  *  @return size of memory in use (in bytes)
  */
 size_t radixMemoryUsage(Radix *radix);
 
+/**
+ * Radix Counters
+ *  This function returns the counters of the calling thread,
+ *  e.g. read before and after an operation to attribute its latency.
+ *
+ *  Builds with RADIX_STATS_PROBES defined also provide USDT probes
+ *  radix:compare (matched bits, compared key bits) and radix:skip
+ *  (node, item size) for tracers.
+ *
+ *  @return RadixCounters object (zeroed without RADIX_STATS)
+ */
+RadixCounters radixCounters(void);
+
+/**
+ * Radix Counters Reset
+ *  This function zeroes the counters of the calling thread.
+ */
+void radixCountersReset(void);
+
+/**
+ * Radix Stats
+ *  This function returns the structure statistics, e.g. for sizing
+ *  the memory or deciding when to rebuild the structure.
+ *
+ *  Counters are maintained by inserts and restores, so the cheap mode
+ *  costs nothing. The full walk visits every node and item, it computes
+ *  the same counters and the depths of visible values.
+ *
+ *  @param radix radix tree
+ *  @param walk whether to walk the whole structure (otherwise depths are zeroed)
+ *  @return RadixStats object
+ */
+RadixStats radixStats(Radix *radix, bool walk);
+
+/**
+ * Radix Freeze
+ *  This function writes the compact read-only copy of the structure
+ *  to the other radix, e.g. for datasets built once and then only read.
+ *
+ *  The copy contains only the values visible by non-nullable functions
+ *  (no history, removed keys and options), stored as pointer-free records
+ *  in the key order - the flags, the key part, the data and the 32-bit
+ *  offset of the greater child (records of single children are merged).
+ *  Data is copied (referenced and logged data too, compressed data is
+ *  decompressed), so the copy does not depend on the source structure
+ *  and its values do not expire.
+ *
+ *  Matches, iterations in the key order, predecessors and keys work
+ *  on the copy (nullable functions find the same values), chronological
+ *  iterations and histories find nothing, inserts return empty values,
+ *  checkpoints are not restored, deltas are not written or applied
+ *  and images are imported only by the same layout.
+ *
+ *  @param radix radix tree
+ *  @param frozen radix tree receiving the copy (its contents are cleared)
+ *  @return success or specific error (out of memory also if a subtree exceeds 4 GiB)
+ */
+RadixError radixFreeze(Radix *radix, Radix *frozen);
+
+/**
+ * Radix Export Size
+ *  This function returns the size of the image written by radixExport.
+ *
+ *  @param radix radix tree
+ *  @return size of the image (in bytes)
+ */
+size_t radixExportSize(Radix *radix);
+
+/**
+ * Radix Export
+ *  This function writes the image of the structure memory in use,
+ *  e.g. for snapshots shipped between machines. The image starts with
+ *  the versioned header describing the layout (byte order, word sizes
+ *  and field offsets) checked by its own CRC32C and every 64 KiB block
+ *  is checked by CRC32C.
+ *
+ *  Referenced data and the value log are not part of the structure memory,
+ *  so structures storing them are not exported.
+ *
+ *  @param radix radix tree
+ *  @param output memory receiving the image
+ *  @param outputSize output size (at least radixExportSize)
+ *  @return success or specific error
+ */
+RadixError radixExport(Radix *radix, unsigned char *output, size_t outputSize);
+
+/**
+ * Radix Import
+ *  This function replaces the contents of the structure with the image
+ *  written by radixExport. All checksums are verified before anything
+ *  is copied, so the rejected image leaves the structure untouched.
+ *  Image of the same layout is copied as is (all addresses are relative).
+ *  Image of the other layout (e.g. other byte order or RADIX_COMPACT)
+ *  is translated - its latest visible values are inserted into the cleared
+ *  structure with their expiry times (no history, removed keys and other
+ *  options), values expired at the current time are skipped.
+ *
+ *  Clock is not part of the image, the structure keeps the clock
+ *  of the radix object.
+ *
+ *  @param radix radix tree
+ *  @param input image
+ *  @param inputSize image size
+ *  @return success or specific error (invalid argument - damaged or unknown image)
+ */
+RadixError radixImport(Radix *radix, unsigned char *input, size_t inputSize);
+
+/**
+ * Radix Stream Export
+ *  This function writes all visible values in the key order as a stream,
+ *  e.g. for backups or warming replicas. Every key is written as its part
+ *  not shared with the previous key, values are prefixed by their size
+ *  and the stream ends with its CRC32C.
+ *
+ *  Buffer is split in halves - copy of the current key and the block
+ *  passed to the write function (larger values are passed directly).
+ *  Expiry times and history are not part of the stream.
+ *
+ *  @param radix radix tree
+ *  @param write function writing the stream
+ *  @param context context passed to the write function
+ *  @param buffer memory for the key and the block
+ *  @param bufferSize buffer size (in bytes)
+ *  @return success or specific error (invalid argument - failed write)
+ */
+RadixError radixStreamExport(Radix *radix, RadixStreamWrite write, void *context, unsigned char *buffer, size_t bufferSize);
+
+/**
+ * Radix Stream Import
+ *  This function inserts values of the stream written by radixStreamExport.
+ *  Sorted keys are inserted from the deepest node shared with the previous
+ *  key (like fingers) and values are inserted right from the read block.
+ *
+ *  Buffer is split in halves - copy of the current key and the block
+ *  filled by the read function (it has to fit the largest value).
+ *  If the stream can not be imported as a whole, the state before
+ *  the import is restored (except in cache mode, which can not be
+ *  restored - values imported before the error are kept).
+ *
+ *  @param radix radix tree
+ *  @param read function reading the stream
+ *  @param context context passed to the read function
+ *  @param buffer memory for the key and the block
+ *  @param bufferSize buffer size (in bytes)
+ *  @return success or specific error (invalid argument - damaged stream)
+ */
+RadixError radixStreamImport(Radix *radix, RadixStreamRead read, void *context, unsigned char *buffer, size_t bufferSize);
+
+/**
+ * Radix Delta Since
+ *  This function writes the changes of the structure made after
+ *  the checkpoint, e.g. for keeping replicas in sync. The structure memory
+ *  only grows, so the delta is the memory appended after the checkpoint
+ *  and the older nodes linked to it (with the head-node, tables of options
+ *  and the structure meta). The delta ends with its CRC32C.
+ *
+ *  Cache mode reuses the memory in place, so it has no deltas. Referenced
+ *  data and the value log are not part of the structure memory, so changes
+ *  storing them are not written.
+ *
+ *  @param radix radix tree
+ *  @param checkpoint checkpoint of the state the replica has
+ *  @param write function writing the delta
+ *  @param context context passed to the write function
+ *  @return success or specific error (invalid argument - failed write or unsupported changes)
+ */
+RadixError radixDeltaSince(Radix *radix, RadixCheckpoint *checkpoint, RadixStreamWrite write, void *context);
+
+/**
+ * Radix Apply Delta
+ *  This function applies the delta written by radixDeltaSince to the replica
+ *  (e.g. radixCreateReplica) which has the state of the delta checkpoint,
+ *  so deltas are applied in the order they were written. Appended memory
+ *  is read right after the structure and the patches are staged after it,
+ *  the structure is changed only once the whole delta is verified.
+ *
+ *  Remember that the checkpoint of the next delta should be taken
+ *  by the writer after the last delta, and the writer should not restore
+ *  older checkpoints in the meantime.
+ *
+ *  @param radix radix tree (replica)
+ *  @param read function reading the delta
+ *  @param context context passed to the read function
+ *  @return success or specific error (invalid argument - damaged delta or other state)
+ */
+RadixError radixApplyDelta(Radix *radix, RadixStreamRead read, void *context);
+
+/**
+ * Radix Value Log Usage
+ *  This function returns the size of value log memory in use.
+ *
+ *  @param radix radix tree
+ *  @return size of value log memory in use (in bytes)
+ */
+size_t radixValueLogUsage(Radix *radix);
+
+/**
+ * Radix Value Log Collect
+ *  This function copies live values of the value log to the new value log
+ *  memory and switches the structure to it. The old memory can be freed after.
+ *
+ *  Values of items newer than the horizon checkpoint and values visible
+ *  at the horizon are live. Older shadowed values are dropped, their items
+ *  become null data (checkpoints older than the horizon will not work properly).
+ *
+ *  @param radix radix tree
+ *  @param horizon oldest checkpoint that can be restored
+ *  @param valueLog pointer to allocated value log memory (not the current one)
+ *  @param valueLogSize value log memory size (in bytes)
+ *  @return success or specific error
+ */
+RadixError radixValueLogCollect(Radix *radix, RadixCheckpoint *horizon, unsigned char *valueLog, size_t valueLogSize);
+
+/**
+ * Radix Partition
+ *  This function returns the index of the part to which the key belongs
+ *  when building the structure in parallel (by leading key bits).
+ *  @see radixPartCreate
+ *
+ *  Keys shorter than partitionBits do not belong to any part, for them
+ *  the function returns the number of parts (1 << partitionBits).
+ *  They should be inserted directly after stitching.
+ *  If partitionBits is not smaller than the number of bits of size_t,
+ *  the function returns SIZE_MAX.
+ *
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @param partitionBits number of leading key bits selecting the part
+ *  @return part index
+ */
+size_t radixPartition(unsigned char *key, size_t keyBits, size_t partitionBits);
+
+/**
+ * Radix Part Create
+ *  This function creates a radix object operating on the region of the
+ *  given radix memory reserved for the given part.
+ *
+ *  Every part is an independent radix, so each one can be built on its own
+ *  thread, but only with keys for which radixPartition returns its index.
+ *  Remember to clear each part before use (even the ones left empty).
+ *  @see radixClear
+ *  @see radixPartsStitch
+ *
+ *  If the parts do not fit into the radix memory (or the part index is
+ *  out of range), the returned radix has no memory.
+ *
+ *  @param radix radix tree that will own the stitched structure
+ *  @param part part index
+ *  @param partitionBits number of leading key bits selecting the part
+ *  @return Radix object
+ */
+Radix radixPartCreate(Radix *radix, size_t part, size_t partitionBits);
+
+/**
+ * Radix Parts Stitch
+ *  This function joins the parts built in the radix memory under a shared
+ *  head-node, so that the radix can be used by all other functions.
+ *
+ *  The previous contents of the radix are discarded and the parts cannot
+ *  be used after stitching. Checkpoints taken inside parts are not valid.
+ *  Nodes joining the parts are written after the last non-empty part,
+ *  so its region needs free memory for two nodes per part.
+ *  Parts with expiry, cache mode or the value log are not stitched
+ *  (the stitched structure has only one value log).
+ *
+ *  @param radix radix tree
+ *  @param parts array of (1 << partitionBits) parts
+ *  @param partitionBits number of leading key bits selecting the part
+ *  @return success or specific error
+ */
+RadixError radixPartsStitch(Radix *radix, Radix *parts, size_t partitionBits);
+
+/**
+ * Radix Shards Create
+ *  This function creates a radix shards object.
+ *
+ *  Remember to clear each shard before use.
+ *  @see radixClear
+ *
+ *  @param shards array of (1 << shardBits) radix objects
+ *  @param shardBits number of leading key bits selecting the shard
+ *  @return RadixShards object
+ */
+RadixShards radixShardsCreate(Radix *shards, size_t shardBits);
+
+/**
+ * Radix Shards Index
+ *  This function returns the index of the shard owning the given key,
+ *  e.g. to select a lock or writer thread of the shard.
+ *
+ *  Keys shorter than shardBits are completed with zero bits.
+ *
+ *  @param shards radix shards
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @return shard index
+ */
+size_t radixShardsIndex(RadixShards *shards, unsigned char *key, size_t keyBits);
+
+/**
+ * Radix Shards Insert
+ *  This function inserts the data into the shard owning the given key.
+ *  @see radixInsert
+ *
+ *  @param shards radix shards
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @param data pointer to data
+ *  @param dataSize data size (in bytes)
+ *  @return RadixValue object
+ */
+RadixValue radixShardsInsert(RadixShards *shards, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize);
+
+/**
+ * Radix Shards Remove
+ *  This function inserts new null data for this key into the shard owning it.
+ *  @see radixRemove
+ *
+ *  @param shards radix shards
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @return RadixValue object
+ */
+RadixValue radixShardsRemove(RadixShards *shards, unsigned char *key, size_t keyBits);
+
+/**
+ * Radix Shards Match
+ *  This function looks for a record with the exactly matching key
+ *  in the shard owning it.
+ *  returns only an match with non-null data.
+ *  @see radixMatch
+ *
+ *  @param shards radix shards
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @return RadixMatch object
+ */
+RadixMatch radixShardsMatch(RadixShards *shards, unsigned char *key, size_t keyBits);
+
+/**
+ * Radix Shards Match
+ *  This function looks for a record with the exactly matching key
+ *  in the shard owning it.
+ *  returns even if the data is null.
+ *  @see radixMatchNullable
+ *
+ *  @param shards radix shards
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @return RadixMatch object
+ */
+RadixMatch radixShardsMatchNullable(RadixShards *shards, unsigned char *key, size_t keyBits);
+
+/**
+ * Radix Shards Prev (lexicographical order)
+ *  This function will return an iterator pointing to smaller element
+ *  of all shards.
+ *  returns only an iterator with non-null data.
+ *
+ *  Shards own disjoint ranges of keys ordered by shard index, so the merged
+ *  order of all shards is the order of shards followed by their own order.
+ *
+ *  Passing an empty iterator returns an iterator
+ *  pointing to the largest element.
+ *
+ *  @param shards radix shards
+ *  @param iterator radix iterator (returned by shards functions)
+ *  @return radix iterator object
+ */
+RadixIterator radixShardsPrev(RadixShards *shards, RadixIterator *iterator);
+
+/**
+ * Radix Shards Next (lexicographical order)
+ *  This function will return an iterator pointing to greater element
+ *  of all shards.
+ *  returns only an iterator with non-null data.
+ *
+ *  Shards own disjoint ranges of keys ordered by shard index, so the merged
+ *  order of all shards is the order of shards followed by their own order.
+ *
+ *  Passing an empty iterator returns an iterator
+ *  pointing to the smallest element.
+ *
+ *  @param shards radix shards
+ *  @param iterator radix iterator (returned by shards functions)
+ *  @return radix iterator object
+ */
+RadixIterator radixShardsNext(RadixShards *shards, RadixIterator *iterator);
+
+/**
+ * Radix Batch Create
+ *  This function creates a batch object operating on the given entries.
+ *
+ *  @param entries pointer to allocated entries
+ *  @param capacity number of entries (the queue bound)
+ *  @return RadixBatch object
+ */
+RadixBatch radixBatchCreate(RadixBatchEntry *entries, size_t capacity);
+
+/**
+ * Radix Batch Push
+ *  This function queues the insert, it is applied by radixBatchApply.
+ *  The key and data are not copied, they must stay valid until the
+ *  callback is called.
+ *
+ *  Pushing is lock-free - any number of producers can push concurrently
+ *  with each other and with the writer applying the batch.
+ *
+ *  @param batch radix batch
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @param data pointer to data (NULL and 0 size to queue remove)
+ *  @param dataSize data size (in bytes)
+ *  @param callback function called after applying (can be NULL)
+ *  @param context pointer passed to the callback
+ *  @return success or specific error (out of memory if the queue is full)
+ */
+RadixError radixBatchPush(RadixBatch *batch, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize, RadixBatchCallback callback, void *context);
+
+/**
+ * Radix Batch Apply
+ *  This function applies all queued inserts to the radix and frees their
+ *  entries. Entries are sorted by key, so consecutive inserts share their
+ *  path, inserts of the same key keep the order in which they were pushed.
+ *  Only the writer applies the batch - entries still being pushed
+ *  (and the ones after them) are left for the next apply.
+ *
+ *  The batch is applied as a whole - if there is not enough memory,
+ *  the radix is restored to its state before the batch and all callbacks
+ *  receive an empty value. Cache mode can not be restored, so there
+ *  the batch is not all-or-nothing - entries applied before the error
+ *  keep their values (removals receive an empty value as they delete
+ *  the key physically).
+ *
+ *  The checkpoint taken before the batch is kept in the batch object,
+ *  so the whole batch can be undone later.
+ *  @see radixCheckpointRestore
+ *
+ *  @param batch radix batch
+ *  @param radix radix tree
+ *  @return success or specific error
+ */
+RadixError radixBatchApply(RadixBatch *batch, Radix *radix);
+
+/**
+ * Radix Finger
+ *  This function creates a radix finger.
+ *
+ *  When this function is called, the finger points to the head-node.
+ *  Keys longer than the key memory can not be remembered, operations on
+ *  them start from the head-node.
+ *
+ *  @param radix radix tree
+ *  @param keyMemory pointer to memory for the copy of the last key
+ *  @param keyMemorySize key memory size (in bytes)
+ *  @return RadixFinger object
+ */
+RadixFinger radixFinger(Radix *radix, unsigned char *keyMemory, size_t keyMemorySize);
+
+/**
+ * Radix Finger Insert
+ *  This function inserts the data under the given (full) key starting from
+ *  the deepest common ancestor of the key and the finger position.
+ *  Finger is moved to the inserted key.
+ *  @see radixInsert
+ *
+ *  @param finger radix finger
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @param data pointer to data
+ *  @param dataSize data size (in bytes)
+ *  @return RadixValue object
+ */
+RadixValue radixFingerInsert(RadixFinger *finger, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize);
+
+/**
+ * Radix Finger Remove
+ *  This function inserts new null data for the given (full) key starting
+ *  from the deepest common ancestor of the key and the finger position.
+ *  Finger is moved to the removed key.
+ *  @see radixRemove
+ *
+ *  @param finger radix finger
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @return RadixValue object
+ */
+RadixValue radixFingerRemove(RadixFinger *finger, unsigned char *key, size_t keyBits);
+
+/**
+ * Radix Finger Match
+ *  This function looks for a record with the exactly matching (full) key
+ *  starting from the deepest common ancestor of the key and the finger.
+ *  returns only an match with non-null data.
+ *  Finger is moved to the deepest node matching the key.
+ *  @see radixMatch
+ *
+ *  @param finger radix finger
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @return RadixMatch object
+ */
+RadixMatch radixFingerMatch(RadixFinger *finger, unsigned char *key, size_t keyBits);
+
+/**
+ * Radix Finger Match
+ *  This function looks for a record with the exactly matching (full) key
+ *  starting from the deepest common ancestor of the key and the finger.
+ *  returns even if the data is null.
+ *  Finger is moved to the deepest node matching the key.
+ *  @see radixMatchNullable
+ *
+ *  @param finger radix finger
+ *  @param key pointer to key
+ *  @param keyBits key size (in bits)
+ *  @return RadixMatch object
+ */
+RadixMatch radixFingerMatchNullable(RadixFinger *finger, unsigned char *key, size_t keyBits);
+
 #endif
@@ -1,6 +1,114 @@
 #include <radix.h>
 
 #include <limits.h>
+#include <stdatomic.h>
+
+// Filter block is one cache line, each key sets RADIX_FILTER_PROBES bits in one block
+#define RADIX_FILTER_BLOCK_SIZE 64
+#define RADIX_FILTER_PROBES 6
+
+// Compressor finds matches through the table of 2^RADIX_COMPRESS_TABLE_BITS last positions (kept on the stack)
+#define RADIX_COMPRESS_TABLE_BITS 12
+
+// Aligned nodes never straddle two cache lines
+#define RADIX_CACHE_LINE_SIZE 64
+
+// Shorter key fragments are not shared (entry of the fragment table would take more memory)
+#define RADIX_FRAGMENT_MIN_SIZE 4
+
+// Cache blocks are power-of-two multiples of the smallest block (free buddies are merged)
+#define RADIX_CACHE_BLOCK_SIZE 32
+#define RADIX_CACHE_CLASSES 32
+
+// Eviction visits at most RADIX_CACHE_CLOCK_STEPS blocks, insert evicts at most RADIX_CACHE_EVICTIONS keys
+#define RADIX_CACHE_CLOCK_STEPS 32
+#define RADIX_CACHE_EVICTIONS 16
+
+// Frozen record is the flags, the offset of the greater child (only if both children exist),
+// the edge and the data (sizes are LEB128), the smaller child follows the record
+#define RADIX_FROZEN_OFFSET_SIZE 4
+#define RADIX_FROZEN_NUMBER_SIZE 10
+#define RADIX_FROZEN_HEADER_SIZE (1 + RADIX_FROZEN_OFFSET_SIZE + RADIX_FROZEN_NUMBER_SIZE)
+
+// Image is the header (numbers are little-endian), CRC32C of every block and the structure memory
+#define RADIX_IMAGE_VERSION 1
+#define RADIX_IMAGE_HEADER_SIZE 56
+#define RADIX_IMAGE_BLOCK_SIZE 65536
+
+// Layout bytes of the header (byte order, word sizes and field offsets) are compared by imports
+#define RADIX_IMAGE_LAYOUT_FORE 8
+#define RADIX_IMAGE_LAYOUT_SIZE 28
+
+// Stream is the header, records (front-coded key and length-prefixed data, numbers are LEB128) and CRC32C
+#define RADIX_STREAM_VERSION 1
+#define RADIX_STREAM_HEADER_SIZE 5
+#define RADIX_STREAM_NUMBER_SIZE 10
+
+// Delta is the header (with the image layout), records (kind, offset and size, then bytes) and CRC32C
+#define RADIX_DELTA_VERSION 1
+#define RADIX_DELTA_HEADER_SIZE 50
+#define RADIX_DELTA_RECORD_SIZE 17
+#define RADIX_DELTA_BLOCK_SIZE 1024
+
+// Checksums use the CRC32C instruction if the target has it
+#if defined(__SSE4_2__) && defined(__x86_64__)
+    #include <nmmintrin.h>
+    #define RADIX_CRC32C_WORD(crc, word) ((uint32_t)_mm_crc32_u64((crc), (word)))
+#elif defined(__ARM_FEATURE_CRC32) && defined(__aarch64__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #include <arm_acle.h>
+    #define RADIX_CRC32C_WORD(crc, word) (__crc32cd((crc), (word)))
+#endif
+
+// Compact layout stores node and item offsets in 32 bits (arena is limited to 4 GiB)
+#ifdef RADIX_COMPACT
+typedef uint32_t Offset;
+#else
+typedef size_t Offset;
+#endif
+
+// Instrumentation (RADIX_STATS) counts the work of the calling thread,
+// without it the counters compile to nothing
+#ifdef RADIX_STATS
+    #if defined(_MSC_VER)
+        #define RADIX_THREAD_LOCAL __declspec(thread)
+    #else
+        #define RADIX_THREAD_LOCAL _Thread_local
+    #endif
+
+    static RADIX_THREAD_LOCAL RadixCounters counters;
+
+    #define RADIX_COUNT(counter, count) (counters.counter += (count))
+#else
+    #define RADIX_COUNT(counter, count) ((void)0)
+#endif
+
+// USDT probes (RADIX_STATS_PROBES, requires sys/sdt.h) are nops until a tracer attaches to them,
+// builds without the header (CMake refuses to configure them) get no probes
+#if defined(RADIX_STATS_PROBES) && defined(__linux__) && defined(__has_include)
+    #if __has_include(<sys/sdt.h>)
+        #include <sys/sdt.h>
+
+        #define RADIX_PROBE(name, a, b) DTRACE_PROBE2(radix, name, a, b)
+    #endif
+#endif
+
+#ifndef RADIX_PROBE
+    #define RADIX_PROBE(name, a, b) ((void)0)
+#endif
+
+// Counts the node visited by the iteration (its null data item is skipped by non-nullable iterations)
+#if defined(RADIX_STATS) || defined(RADIX_STATS_PROBES)
+    #define RADIX_COUNT_VISIT(item) \
+        do { \
+            RADIX_COUNT(nodesVisited, 1); \
+            if ((item) && itemSize(item) == 0) { \
+                RADIX_COUNT(nullItemsSkipped, 1); \
+                RADIX_PROBE(skip, (item)->node, (item)->size); \
+            } \
+        } while (0)
+#else
+    #define RADIX_COUNT_VISIT(item) ((void)0)
+#endif
 
 typedef struct Meta {
     // Stores the last radix node(chronologically)
@@ -11,47 +119,279 @@ typedef struct Meta {
 
     // Information needed for memory management
     size_t structureEnd;
+
+    // Stores the exact-match hash index (0 - index disabled)
+    size_t index;
+    size_t indexSlots;
+    size_t indexCount;
+
+    // Stores whether some keys could not be indexed (index is full)
+    bool indexOverflow;
+
+    // Stores the blocked bloom filter of keys (0 - filter disabled)
+    size_t filter;
+    size_t filterBlocks;
+    size_t filterKeys;
+
+    // Stores the value log state (0 - value log disabled)
+    size_t valueThreshold;
+    size_t valueLogEnd;
+
+    // Stores the data deduplication table (0 - deduplication disabled)
+    size_t dedup;
+    size_t dedupSlots;
+    size_t dedupCount;
+
+    // Stores the minimal size of compressed data (0 - compression disabled)
+    size_t compressThreshold;
+
+    // Stores the key fragment table (0 - key fragments are not shared)
+    size_t fragment;
+    size_t fragmentSlots;
+    size_t fragmentCount;
+
+    // Stores whether the structure is read-only (radixFreeze)
+    bool frozen;
+
+    // Stores whether nodes are aligned to cache lines
+    bool alignNodes;
+
+    // Stores whether items are preceded by versions (ItemVersion)
+    bool versions;
+
+    // Stores the expiry heap, items are preceded by expiry times (0 - expiry disabled)
+    size_t expiry;
+    size_t expirySlots;
+    size_t expiryCount;
+
+    // Stores whether some expiring items could not be added to the heap (heap is full)
+    bool expiryOverflow;
+
+    // Stores the cache region - blocks of nodes and items, keys are evicted by the CLOCK hand (0 - cache mode disabled)
+    size_t cache;
+    size_t cacheEnd;
+    size_t cacheHand;
+    size_t cacheEvictions;
+
+    // Stores the free blocks by size classes
+    size_t cacheFree[RADIX_CACHE_CLASSES];
+
+    // Stores the time index (0 - time index disabled)
+    size_t time;
+    size_t timeSlots;
+    size_t timeCount;
+    size_t timeStride;
+    size_t timeSkipped;
+    size_t timeOrigin;
+
+    // Stores the statistics maintained by inserts and restores (radixStats)
+    size_t nodeCount;
+    size_t itemCount;
+    size_t liveCount;
+    size_t nullCount;
+    size_t keyBytes;
+    size_t valueBytes;
+    size_t deadBytes;
 } Meta;
 
 typedef struct Node {
-    // Stores parent (lexicographically)
-    size_t parent;
+    // Hot fields (read by every step of the descent) are placed first,
+    // so they share the cache line with the key bytes stored after the node
 
     // Stores children (lexicographically)
-    size_t childSmaller;
-    size_t childGreater;
+    Offset childSmaller;
+    Offset childGreater;
 
     // Stores the key address
-    size_t keyFore;
-    size_t keyRear;
+    Offset keyFore;
+    Offset keyRear;
 
     struct {
         // Stores the bit offset (cooperates with keyFore and keyRear)
         unsigned char keyForeOffset : 3;
         unsigned char keyRearOffset : 3;
+
+        // Stores whether the subtree has visible values (non-nullable iterations skip subtrees without them)
+        unsigned char live : 1;
     };
 
     // Stores item
-    size_t item;
+    Offset item;
+
+    // Stores parent (lexicographically)
+    Offset parent;
 
     // Stores the last radix node before being added
-    size_t lastNode;
+    Offset lastNode;
 } Node;
 
 typedef struct Item {
     // Stores the data
-    size_t size;
+    Offset size;
 
     // Stores the owner node
-    size_t node;
+    Offset node;
 
     // Stores the last node item before being added (chronologically)
-    size_t previous;
+    Offset previous;
 
     // Stores the last radix item before being added(chronologically)
-    size_t lastItem;
+    Offset lastItem;
 } Item;
 
+#ifdef RADIX_COMPACT
+// Compact layout must not grow unnoticed - node is 8 offsets (bit offsets fit the padding), item is 4 offsets
+typedef char CompactNodeSize[sizeof(Node) == 8 * sizeof(Offset) ? 1 : -1];
+typedef char CompactItemSize[sizeof(Item) == 4 * sizeof(Offset) ? 1 : -1];
+#endif
+
+// Item size stores the data kind in its top bits
+#define ITEM_KIND_BITS 3
+#define ITEM_KIND_SHIFT (sizeof(Offset) * CHAR_BIT - ITEM_KIND_BITS)
+#define ITEM_SIZE_MASK (((Offset)1 << ITEM_KIND_SHIFT) - 1)
+
+typedef enum ItemKind {
+    // Data is stored right after the item
+    ITEM_INLINE,
+
+    // Data is owned by the caller, ItemReference is stored right after the item
+    ITEM_REFERENCE,
+
+    // Data is stored in the value log, ItemLog is stored right after the item
+    ITEM_LOG,
+
+    // Data is shared with the older inline item, ItemShared is stored right after the item
+    ITEM_SHARED,
+
+    // Data is compressed, ItemCompressed and the compressed data are stored right after the item
+    ITEM_COMPRESSED,
+} ItemKind;
+
+typedef struct ItemVersion {
+    // Stores the version number of the key (the first item is 1)
+    Offset number;
+
+    // Stores the skip pointer to the earlier item of the key (the first item points to itself)
+    Offset jump;
+} ItemVersion;
+
+typedef struct ItemExpiry {
+    // Stores the clock time when the data expires (0 - never)
+    uint64_t expires;
+} ItemExpiry;
+
+typedef struct ItemReference {
+    unsigned char *data;
+
+    // Stores the release callback
+    RadixReleaseCallback release;
+    void *context;
+} ItemReference;
+
+typedef struct ItemLog {
+    // Stores the data address in the value log
+    size_t offset;
+} ItemLog;
+
+typedef struct ItemShared {
+    // Stores the item with the data
+    Offset item;
+} ItemShared;
+
+typedef struct ItemCompressed {
+    // Stores the compressed data size
+    Offset size;
+} ItemCompressed;
+
+typedef struct IndexEntry {
+    // Stores the key hash
+    uint64_t hash;
+
+    // Stores the indexed key (0 - empty entry)
+    size_t key;
+} IndexEntry;
+
+typedef struct TimeEntry {
+    // Stores the indexed item
+    Offset item;
+
+    // Stores the structure state after the item was inserted
+    Offset state;
+
+    // Stores the clock time of the insert
+    uint64_t time;
+} TimeEntry;
+
+typedef struct ExpiryEntry {
+    // Stores the expiry time of the item
+    uint64_t expires;
+
+    // Stores the expiring item
+    Offset item;
+} ExpiryEntry;
+
+typedef enum CacheKind {
+    CACHE_FREE,
+    CACHE_NODE,
+    CACHE_ITEM,
+} CacheKind;
+
+typedef struct CacheBlock {
+    // Stores the size class (the block size is RADIX_CACHE_BLOCK_SIZE << sizeClass)
+    unsigned char sizeClass;
+
+    // Stores the block content (CacheKind)
+    unsigned char kind;
+
+    // Stores the CLOCK reference bit (set by matches of the item)
+    unsigned char referenced;
+} CacheBlock;
+
+typedef struct CacheFree {
+    // Stores the free blocks of the same size class (0 - none)
+    Offset next;
+    Offset previous;
+} CacheFree;
+
+typedef struct IndexKey {
+    // Stores the owner node
+    Offset node;
+
+    // Stores the key size (the key is stored right after)
+    Offset keyBits;
+} IndexKey;
+
+typedef enum FrozenFlag {
+    FROZEN_VALUE = 1,
+    FROZEN_SMALLER = 2,
+    FROZEN_GREATER = 4,
+} FrozenFlag;
+
+typedef struct FrozenRecord {
+    // Stores the record address and the address after its data (the first child)
+    size_t address;
+    size_t end;
+
+    unsigned char flags;
+
+    // Stores the edge (bits from the parent record)
+    unsigned char *key;
+    size_t keyBits;
+
+    unsigned char *data;
+    size_t dataSize;
+
+    // Stores children (0 - no child)
+    size_t childSmaller;
+    size_t childGreater;
+} FrozenRecord;
+
+typedef enum FrozenMatch {
+    FROZEN_MATCH_EXACT,
+    FROZEN_MATCH_FIRST,
+    FROZEN_MATCH_LONGEST,
+} FrozenMatch;
+
 static inline bool bitGet(unsigned char *stream, size_t bitIndex)
 {
     if (stream == NULL)
@@ -101,13 +441,18 @@ static inline size_t bitCompare(unsigned char *a, size_t aFore, size_t aRear, un
 
     size_t maxSize = aSize < bSize ? aSize : bSize;
 
-    for (size_t i = 0; i < maxSize; i++) {
-        if (bitGet(a, aFore + i) != bitGet(b, bFore + i)) {
-            return i;
-        }
+    size_t i = 0;
+
+    while (i < maxSize && bitGet(a, aFore + i) == bitGet(b, bFore + i)) {
+        i++;
     }
 
-    return maxSize;
+    // Every comparison checks the key of one node (the mismatching bit is compared too)
+    RADIX_COUNT(nodesVisited, 1);
+    RADIX_COUNT(bitsCompared, i < maxSize ? i + 1 : maxSize);
+    RADIX_PROBE(compare, i, maxSize);
+
+    return i;
 }
 
 static inline void byteCopy(unsigned char *destination, const unsigned char* source, size_t size)
@@ -120,1840 +465,7157 @@ static inline void byteCopy(unsigned char *destination, const unsigned char* sou
     }
 }
 
-Radix radixCreate(unsigned char *memory, size_t memorySize)
+static inline uint32_t compressRead(const unsigned char *stream)
 {
-    return (Radix){
-        .memory = memory,
-        .memorySize = memorySize,
-    };
+    return (uint32_t)stream[0] | (uint32_t)stream[1] << 8 | (uint32_t)stream[2] << 16 | (uint32_t)stream[3] << 24;
 }
 
-RadixIterator radixIterator(Radix *radix)
+static inline size_t compressLength(unsigned char *output, size_t outputPos, size_t length)
 {
-    return (RadixIterator){
-        .radix = radix,
-        .node = 0,
-        .data = NULL,
-        .dataSize = 0,
-    };
-}
+    for (; length >= UCHAR_MAX; length -= UCHAR_MAX) {
+        output[outputPos++] = UCHAR_MAX;
+    }
 
-RadixValue radixValueIterator(Radix *radix)
-{
-    return (RadixValue){
-        .radix = radix,
-        .item = 0,
-        .data = NULL,
-        .dataSize = 0,
-    };
+    output[outputPos++] = (unsigned char)length;
+
+    return outputPos;
 }
 
-RadixValue radixInsert(RadixIterator* iterator, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize)
+static inline bool compressSequence(unsigned char *output, size_t outputSize, size_t *outputPos, const unsigned char *literals, size_t literalSize, size_t offset, size_t matchSize)
 {
-    Radix *radix = iterator->radix;
+    size_t matchCode = matchSize != 0 ? matchSize - 4 : 0;
 
-    Meta *meta = (Meta *)radix->memory;
+    // Upper bound of the sequence size (token, literal size, literals, offset, match size)
+    size_t sequenceSize = 1 + literalSize / UCHAR_MAX + 1 + literalSize + (matchSize != 0 ? 2 + matchCode / UCHAR_MAX + 1 : 0);
 
-    RadixValue result = {0};
+    if (sequenceSize > outputSize - *outputPos)
+        return false;
 
-    result.radix = radix;
+    size_t pos = *outputPos;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    // Token stores literal size and match size in nibbles (15 - size continues in the following bytes)
+    output[pos++] = (unsigned char)((literalSize < 15 ? literalSize : 15) << 4 | (matchCode < 15 ? matchCode : 15));
 
-    // If node is null, this means we should start with the head-node
-    if (!node) {
-        // If the structure has not been managed before, it may need to be initialized
-        if (meta->lastNode == 0) {
-            // Calculate needed memory
-            size_t neededMemory = sizeof(Meta) + sizeof(Node);
+    if (literalSize >= 15)
+        pos = compressLength(output, pos, literalSize - 15);
 
-            // Check free memory
-            if (neededMemory > radix->memorySize - meta->structureEnd)
-                return result;
+    byteCopy(output + pos, literals, literalSize);
+    pos += literalSize;
 
-            // Compose memory
-            node = (Node *) (radix->memory + sizeof(Meta));
+    if (matchSize != 0) {
+        output[pos++] = (unsigned char)(offset & 0xff);
+        output[pos++] = (unsigned char)(offset >> 8);
 
-            // Write head node
-            *node = (Node) {0};
+        if (matchCode >= 15)
+            pos = compressLength(output, pos, matchCode - 15);
+    }
 
-            // Write meta information
-            *meta = (Meta) {
-                .lastNode = (unsigned char *)node - radix->memory,
-                .lastItem = 0,
-                .structureEnd = neededMemory,
-            };
-        }
+    *outputPos = pos;
 
-        node = (Node *) (radix->memory + sizeof(Meta));
-    }
+    return true;
+}
 
-    // Insert node - iterate thought structure and create new edge-nodes
-    for (size_t keyPos = 0; keyPos < keyBits;) {
-        // Get direction of iteration
-        bool direction = bitGet(key, keyPos);
+// LZ4-like block compression (sequences of literals and back-references of at least 4 bytes)
+// Returns 0 when the compressed data does not fit the output
+static inline size_t compress(const unsigned char *input, size_t inputSize, unsigned char *output, size_t outputSize)
+{
+    uint32_t table[1 << RADIX_COMPRESS_TABLE_BITS] = {0}; // stores positions + 1 (0 - empty)
 
-        // Iterate..
-        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+    size_t inputPos = 0;
+    size_t literalFore = 0;
+    size_t outputPos = 0;
 
-        // If there is no child ..create it and end iteration
-        if (childAddress == 0) {
-            // Calculate needed memory
-            size_t neededMemory = sizeof(Node) + ((keyBits - keyPos + CHAR_BIT - 1) / CHAR_BIT);
+    while (inputPos + 4 <= inputSize) {
+        uint32_t sequence = compressRead(input + inputPos);
+        size_t slot = (uint32_t)(sequence * 2654435761u) >> (32 - RADIX_COMPRESS_TABLE_BITS);
 
-            // Check free memory
-            if (neededMemory > radix->memorySize - meta->structureEnd) {
-                return result;
-            }
+        size_t candidate = table[slot];
+        table[slot] = (uint32_t)(inputPos + 1);
 
-            // Compose memory
-            Node *newNode = (Node*) (radix->memory + meta->structureEnd);
-            unsigned char *newKey = (unsigned char *) newNode + sizeof(Node);
+        if (candidate == 0 || inputPos - (candidate - 1) > 0xffff || compressRead(input + candidate - 1) != sequence) {
+            inputPos++;
+            continue;
+        }
 
-            // Write node
-            *newNode = (Node) {
-                .parent = (unsigned char *)node - radix->memory,
-                .childSmaller = 0,
-                .childGreater = 0,
-                .keyFore = newKey - radix->memory,
-                .keyRear = newKey - radix->memory + ((keyBits - keyPos) / CHAR_BIT),
-                .keyForeOffset = 0,
-                .keyRearOffset = ((keyBits - keyPos) % CHAR_BIT),
-                .lastNode = meta->lastNode,
-                .item = 0,
-            };
+        candidate--;
 
-            // Write key
-            bitCopy(key, keyPos, newKey, 0, keyBits - keyPos);
+        size_t matchSize = 4;
 
-            // Set new node as node child
-            size_t *nodeChild = direction ? &(node->childGreater) : &(node->childSmaller);
+        while (inputPos + matchSize < inputSize && input[candidate + matchSize] == input[inputPos + matchSize]) {
+            matchSize++;
+        }
 
-            *nodeChild = (unsigned char *)newNode - radix->memory;
+        if (!compressSequence(output, outputSize, &outputPos, input + literalFore, inputPos - literalFore, inputPos - candidate, matchSize))
+            return 0;
 
-            // Update meta information
-            meta->lastNode = (unsigned char *)newNode - radix->memory;
-            meta->structureEnd += neededMemory;
+        inputPos += matchSize;
+        literalFore = inputPos;
+    }
 
-            // Assign new node as current node
-            node = newNode;
+    // Last sequence has only literals
+    if (!compressSequence(output, outputSize, &outputPos, input + literalFore, inputSize - literalFore, 0, 0))
+        return 0;
 
-            break;
-        }
+    return outputPos;
+}
 
-        // Check if the key is correct
-        Node *testNode = (Node *) (radix->memory + childAddress);
+static inline bool decompressLength(const unsigned char *input, size_t inputSize, size_t *inputPos, size_t *length)
+{
+    unsigned char byte;
 
-        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+    do {
+        if (*inputPos >= inputSize)
+            return false;
 
-        size_t testKeyFore = testNode->keyForeOffset;
-        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+        byte = input[(*inputPos)++];
+        *length += byte;
+    } while (byte == UCHAR_MAX);
 
-        size_t testKeyBits = testKeyRear - testKeyFore;
+    return true;
+}
 
-        // Compare key with testKey
-        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+static inline bool decompress(const unsigned char *input, size_t inputSize, unsigned char *output, size_t outputSize)
+{
+    size_t inputPos = 0;
+    size_t outputPos = 0;
 
-        // If key is not fully maching ..split this node and continue iteration
-        if (matchedBits < testKeyBits) {
-            // Calculate needed memory
-            size_t neededMemory = sizeof(Node);
+    while (inputPos < inputSize) {
+        unsigned char token = input[inputPos++];
 
-            // Check free memory
-            if (neededMemory > radix->memorySize - meta->structureEnd) {
-                return result;
-            }
+        // Copy literals
+        size_t literalSize = token >> 4;
 
-            // Compose memory
-            Node *newNode = (Node *) (radix->memory + meta->structureEnd);
+        if (literalSize == 15 && !decompressLength(input, inputSize, &inputPos, &literalSize))
+            return false;
 
-            // Get split direction
-            bool splitDirection = bitGet(
-                (unsigned char *) (radix->memory + testNode->keyFore),
-                testNode->keyForeOffset + matchedBits
-            );
+        if (literalSize > inputSize - inputPos || literalSize > outputSize - outputPos)
+            return false;
 
-            // Write split node
-            *newNode = (Node) {
-                .parent = testNode->parent,
-                .childSmaller = splitDirection ? 0 : (unsigned char *)testNode - radix->memory,
-                .childGreater = splitDirection ? (unsigned char *)testNode - radix->memory : 0,
-                .keyFore = testNode->keyFore,
-                .keyRear = testNode->keyFore + ((testNode->keyForeOffset + matchedBits) / CHAR_BIT),
-                .keyForeOffset = testNode->keyForeOffset,
-                .keyRearOffset = (testNode->keyForeOffset + matchedBits) % CHAR_BIT,
-                .lastNode = meta->lastNode,
-                .item = 0,
-            };
+        byteCopy(output + outputPos, input + inputPos, literalSize);
+        inputPos += literalSize;
+        outputPos += literalSize;
 
-            // Update splited node
-            testNode->parent = (unsigned char *)newNode - radix->memory;
-            testNode->keyFore = newNode->keyRear;
-            testNode->keyForeOffset = newNode->keyRearOffset;
+        // Last sequence has only literals
+        if (inputPos == inputSize)
+            break;
 
-            // Set new node as node child
-            size_t *nodeChild = direction ? &(node->childGreater) : &(node->childSmaller);
+        // Copy match (byte by byte, overlapping match repeats the data)
+        if (2 > inputSize - inputPos)
+            return false;
 
-            *nodeChild = (unsigned char *)newNode - radix->memory;
+        size_t offset = (size_t)input[inputPos] | (size_t)input[inputPos + 1] << 8;
+        inputPos += 2;
 
-            // Update meta information
-            meta->lastNode = (unsigned char *)newNode - radix->memory;
-            meta->structureEnd += neededMemory;
+        size_t matchSize = token & 15;
 
-            // Assign new node as fully maching node
-            testNode = newNode;
-        }
+        if (matchSize == 15 && !decompressLength(input, inputSize, &inputPos, &matchSize))
+            return false;
 
-        // key is fully correct, set testNode as node
-        node = testNode;
-        keyPos += matchedBits;
-    }
+        matchSize += 4;
 
-    // Insert item
-    // Node is matched, so add a new item to the structure
-    {
-        // Calculate needed memory
-        size_t neededMemory = sizeof(Item) + dataSize;
+        if (offset == 0 || offset > outputPos || matchSize > outputSize - outputPos)
+            return false;
 
-        // Check free memory
-        if (neededMemory > radix->memorySize - meta->structureEnd) {
-            return result;
+        for (size_t i = 0; i < matchSize; i++) {
+            output[outputPos + i] = output[outputPos - offset + i];
         }
 
-        // Compose memory
-        Item *newItem = (Item *) (radix->memory + meta->structureEnd);
-        unsigned char *newData = (unsigned char *)newItem + sizeof(Item);
+        outputPos += matchSize;
+    }
 
-        // Write item
-        *newItem = (Item) {
-            .size = dataSize,
-            .node = (unsigned char *)node - radix->memory,
-            .previous = node->item,
-            .lastItem = meta->lastItem,
-        };
+    return outputPos == outputSize;
+}
 
-        // Write data
-        byteCopy(newData, data, dataSize);
+static inline ItemKind itemKind(Item *item)
+{
+    return (ItemKind)(item->size >> ITEM_KIND_SHIFT);
+}
 
-        // Update node
-        node->item = (unsigned char *)newItem - radix->memory;
+static inline size_t itemSize(Item *item)
+{
+    return item->size & ITEM_SIZE_MASK;
+}
 
-        // Update meta information
-        meta->lastItem = (unsigned char *)newItem - radix->memory;
-        meta->structureEnd += neededMemory;
+// Returns the memory stored right after the item (data, its reference, log offset, shared item or compressed data)
+static inline unsigned char *itemStorage(Item *item)
+{
+    return (unsigned char *)item + sizeof(Item);
+}
 
-        // Update result
-        result.item = (unsigned char *)newItem - radix->memory;
-        result.data = newData;
-        result.dataSize = dataSize;
+// Returns the size of memory stored right after the item
+static inline size_t itemStorageSize(Item *item)
+{
+    switch (itemKind(item)) {
+        case ITEM_REFERENCE: return sizeof(ItemReference);
+        case ITEM_LOG: return sizeof(ItemLog);
+        case ITEM_SHARED: return sizeof(ItemShared);
+        case ITEM_COMPRESSED: return sizeof(ItemCompressed) + ((ItemCompressed *) itemStorage(item))->size;
+        default: return itemSize(item);
     }
+}
 
-    return result;
+static inline unsigned char *itemData(Radix *radix, Item *item)
+{
+    switch (itemKind(item)) {
+        case ITEM_REFERENCE: return ((ItemReference *) itemStorage(item))->data;
+        case ITEM_LOG: return radix->valueLog + ((ItemLog *) itemStorage(item))->offset;
+        case ITEM_SHARED: return itemStorage((Item *) (radix->memory + ((ItemShared *) itemStorage(item))->item));
+        case ITEM_COMPRESSED: return NULL; // data has to be decompressed (radixValueRead)
+        default: return itemStorage(item);
+    }
 }
 
-RadixValue radixRemove(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+static inline ItemVersion *itemVersion(Item *item)
 {
-    return radixInsert(iterator, key, keyBits, NULL, 0);
+    // Version is stored right before the item
+    return (ItemVersion *) ((unsigned char *)item - sizeof(ItemVersion));
 }
 
-RadixMatch radixMatch(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+// Returns the size of memory stored right before the item
+static inline size_t itemPrefixSize(Meta *meta)
 {
-    Radix *radix = iterator->radix;
+    return (meta->expiry != 0 ? sizeof(ItemExpiry) : 0) + (meta->versions ? sizeof(ItemVersion) : 0);
+}
 
-    Meta *meta = (Meta *)radix->memory;
+static inline ItemExpiry *itemExpiry(Meta *meta, Item *item)
+{
+    // Expiry is stored before the version
+    return (ItemExpiry *) ((unsigned char *)item - itemPrefixSize(meta));
+}
 
-    RadixMatch result = {0};
+// Returns the size of memory taken by the item
+static inline size_t itemMemory(Meta *meta, Item *item)
+{
+    return itemPrefixSize(meta) + sizeof(Item) + itemStorageSize(item);
+}
 
-    result.radix = radix;
+// Returns the time of the clock (0 - the radix has no clock)
+static inline uint64_t clockTime(Radix *radix)
+{
+    return radix->clock ? radix->clock(radix->clockContext) : 0;
+}
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+// Returns the time items are checked against by the operation, the clock is read once
+// per operation and only if items expire (0 - nothing is expired)
+static inline uint64_t itemTime(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-    // If node is null, this means we should start with the head-node
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+    return meta->expiry != 0 ? clockTime(radix) : 0;
+}
 
-        node = (Node *) (radix->memory + sizeof(Meta));
-    }
+// Returns whether the item has visible data at the time of the operation (not null and not expired)
+static inline bool itemVisible(Radix *radix, Item *item, uint64_t time)
+{
+    if (!item || itemSize(item) == 0)
+        return false;
 
-    for (size_t keyPos = 0; true;) {
-        // If keyPos has reached the size ..end iteration
-        if (keyPos >= keyBits) {
-            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    Meta *meta = (Meta *)radix->memory;
 
-            // If matched node has item (not nullable) - update match
-            if (item && item->size > 0) {
-                result.node = (unsigned char *)node - radix->memory;
-                result.matchedBits = keyPos;
-                result.data = (unsigned char*)item + sizeof(Item);
-                result.dataSize = item->size;
-            }
+    if (meta->expiry == 0)
+        return true;
 
-            break;
-        }
+    uint64_t expires = itemExpiry(meta, item)->expires;
 
-        // Get direction of iteration
-        bool direction = bitGet(key, keyPos);
+    return expires == 0 || time < expires;
+}
 
-        // Iterate..
-        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+static inline void itemRelease(Item *item)
+{
+    if (itemKind(item) == ITEM_REFERENCE) {
+        ItemReference *reference = (ItemReference *) itemStorage(item);
 
-        // If there is no child ..break
-        if (childAddress == 0)
-            break;
+        if (reference->release)
+            reference->release(reference->context, reference->data, itemSize(item));
+    }
+}
 
-        // Check if the key is correct
-        Node *testNode = (Node *) (radix->memory + childAddress);
+// Returns the size of key memory stored right after the node (0 - key is stored by another node)
+static inline size_t nodeKeyMemory(Radix *radix, Node *node)
+{
+    size_t keyAddress = (unsigned char *)node - radix->memory + sizeof(Node);
 
-        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+    if (node->keyRear < keyAddress)
+        return 0;
 
-        size_t testKeyFore = testNode->keyForeOffset;
-        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+    return node->keyRear - keyAddress + (node->keyRearOffset != 0);
+}
 
-        size_t testKeySize = testKeyRear - testKeyFore;
+// Returns the child if its subtree has visible values (0 - no child or no visible values)
+static inline size_t liveChild(Radix *radix, size_t childAddress)
+{
+    return childAddress != 0 && ((Node *) (radix->memory + childAddress))->live ? childAddress : 0;
+}
 
-        // Compare key with testKey
-        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+// Updates the visible values flags from the node up to the first unchanged ancestor
+static inline void liveUpdate(Radix *radix, Node *node)
+{
+    while (node) {
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
 
-        // if key is not fully correct ..break
-        if (matchedBits < testKeySize)
-            break;
+        bool live = (item && itemSize(item) > 0) || liveChild(radix, node->childSmaller) != 0 || liveChild(radix, node->childGreater) != 0;
 
-        // Set child as current node and move key position
-        node = testNode;
-        keyPos += matchedBits;
-    }
+        if (live == node->live)
+            return;
 
-    return result;
+        node->live = live;
+
+        node = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    }
 }
 
-RadixMatch radixMatchNullable(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+// Counts the item that becomes the latest item of its node (the previous one gets shadowed)
+static inline void statsItemAdd(Meta *meta, Item *item, Item *previous)
 {
-    Radix *radix = iterator->radix;
+    meta->itemCount++;
+    meta->valueBytes += itemSize(item);
 
-    Meta *meta = (Meta *)radix->memory;
+    if (previous) {
+        if (itemSize(previous) > 0) {
+            meta->liveCount--;
+            meta->deadBytes += itemMemory(meta, previous);
+        } else {
+            meta->nullCount--;
+        }
+    }
 
-    RadixMatch result = {0};
+    if (itemSize(item) > 0) {
+        meta->liveCount++;
+    } else {
+        meta->nullCount++;
+        meta->deadBytes += itemMemory(meta, item);
+    }
+}
 
-    result.radix = radix;
+// Reverts statsItemAdd (the previous item becomes the latest item again)
+static inline void statsItemRemove(Meta *meta, Item *item, Item *previous)
+{
+    meta->itemCount--;
+    meta->valueBytes -= itemSize(item);
+
+    if (itemSize(item) > 0) {
+        meta->liveCount--;
+    } else {
+        meta->nullCount--;
+        meta->deadBytes -= itemMemory(meta, item);
+    }
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    if (previous) {
+        if (itemSize(previous) > 0) {
+            meta->liveCount++;
+            meta->deadBytes -= itemMemory(meta, previous);
+        } else {
+            meta->nullCount++;
+        }
+    }
+}
 
-    // If node is null, this means we should start with the head-node
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+static inline uint64_t keyHash(unsigned char *key, size_t keyBits)
+{
+    // FNV-1a over the key bytes (bits after the key are masked),
+    // finished with the murmur mixer to spread the bits over index slots
+    uint64_t hash = 14695981039346656037ULL ^ keyBits;
 
-        node = (Node *) (radix->memory + sizeof(Meta));
+    size_t keySize = keyBits / CHAR_BIT;
+
+    for (size_t i = 0; i < keySize; i++) {
+        hash = (hash ^ key[i]) * 1099511628211ULL;
     }
 
-    for (size_t keyPos = 0; true;) {
-        // If keyPos has reached the size ..end iteration
-        if (keyPos >= keyBits) {
-            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    if (keyBits % CHAR_BIT != 0)
+        hash = (hash ^ (key[keySize] & (unsigned char)(UCHAR_MAX << (CHAR_BIT - keyBits % CHAR_BIT)))) * 1099511628211ULL;
 
-            // If matched node has item (nullable) - update match
-            if (item) {
-                result.node = (unsigned char *)node - radix->memory;
-                result.matchedBits = keyPos;
-                result.data = (unsigned char*)item + sizeof(Item);
-                result.dataSize = item->size;
-            }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
 
-            break;
-        }
+    return hash;
+}
 
-        // Get direction of iteration
-        bool direction = bitGet(key, keyPos);
+static inline bool keyEqual(unsigned char *a, unsigned char *b, size_t keyBits)
+{
+    size_t keySize = keyBits / CHAR_BIT;
 
-        // Iterate..
-        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+    for (size_t i = 0; i < keySize; i++) {
+        if (a[i] != b[i])
+            return false;
+    }
 
-        // If there is no child ..break
-        if (childAddress == 0)
-            break;
+    if (keyBits % CHAR_BIT == 0)
+        return true;
 
-        // Check if the key is correct
-        Node *testNode = (Node *) (radix->memory + childAddress);
+    unsigned char mask = UCHAR_MAX << (CHAR_BIT - keyBits % CHAR_BIT);
 
-        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+    return (a[keySize] & mask) == (b[keySize] & mask);
+}
 
-        size_t testKeyFore = testNode->keyForeOffset;
-        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+static inline bool entryAdd(IndexEntry *entries, size_t slots, size_t *count, uint64_t hash, size_t key)
+{
+    // Keep the load factor below 3/4, otherwise the probing gets too long
+    if (4 * (*count + 1) > 3 * slots)
+        return false;
 
-        size_t testKeySize = testKeyRear - testKeyFore;
+    size_t slot = hash & (slots - 1);
 
-        // Compare key with testKey
-        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+    while (entries[slot].key != 0) {
+        slot = (slot + 1) & (slots - 1);
+    }
 
-        // If key is not fully correct ..break
-        if (matchedBits < testKeySize)
-            break;
+    entries[slot] = (IndexEntry) {
+        .hash = hash,
+        .key = key,
+    };
 
-        // Set child as current node and move key position
-        node = testNode;
-        keyPos += matchedBits;
-    }
+    (*count)++;
 
-    return result;
+    return true;
 }
 
-RadixMatch radixMatchFirst(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+static inline void entryRemove(IndexEntry *entries, size_t slots, size_t *count, uint64_t hash, size_t key)
 {
-    Radix *radix = iterator->radix;
-
-    Meta *meta = (Meta *)radix->memory;
+    size_t mask = slots - 1;
 
-    RadixMatch result = {0};
+    size_t slot = hash & mask;
 
-    result.radix = radix;
+    while (entries[slot].key != key) {
+        // The key has not been added (table was full)
+        if (entries[slot].key == 0)
+            return;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+        slot = (slot + 1) & mask;
+    }
 
-    // If node is null, this means we should start with the head-node
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+    // Shift back the following entries of the cluster which would not be found after the removal
+    for (size_t next = (slot + 1) & mask; entries[next].key != 0; next = (next + 1) & mask) {
+        size_t home = entries[next].hash & mask;
 
-        node = (Node *) (radix->memory + sizeof(Meta));
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            entries[slot] = entries[next];
+            slot = next;
+        }
     }
 
-    for (size_t keyPos = 0; true;) {
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    entries[slot] = (IndexEntry) {0};
 
-        // If matched node has item (not nullable) - update match and break
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.matchedBits = keyPos;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    (*count)--;
+}
 
-            break;
-        }
+static inline Node *indexFind(Radix *radix, unsigned char *key, size_t keyBits, uint64_t hash)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        // If keyPos has reached the size of the given key - break
-        if (keyBits <= keyPos)
-            break;
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->index);
 
-        // Get direction of iteration
-        bool direction = bitGet(key, keyPos);
+    // Linear probing until an empty entry
+    for (size_t slot = hash & (meta->indexSlots - 1); entries[slot].key != 0; slot = (slot + 1) & (meta->indexSlots - 1)) {
+        if (entries[slot].hash != hash)
+            continue;
 
-        // Iterate..
-        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+        IndexKey *indexKey = (IndexKey *) (radix->memory + entries[slot].key);
 
-        // If there is no child ..break
-        if (childAddress == 0)
-            break;
+        if (indexKey->keyBits == keyBits && keyEqual(key, (unsigned char *)indexKey + sizeof(IndexKey), keyBits))
+            return (Node *) (radix->memory + indexKey->node);
+    }
 
-        // Check if the key is correct
-        Node *testNode = (Node *) (radix->memory + childAddress);
+    return NULL;
+}
 
-        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+static inline void indexAdd(Radix *radix, IndexKey *indexKey, uint64_t hash)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        size_t testKeyFore = testNode->keyForeOffset;
-        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->index);
 
-        size_t testKeySize = testKeyRear - testKeyFore;
+    if (!entryAdd(entries, meta->indexSlots, &meta->indexCount, hash, (unsigned char *)indexKey - radix->memory))
+        meta->indexOverflow = true;
+}
 
-        // Compare key with testKey
-        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+static inline void indexRemove(Radix *radix, IndexKey *indexKey)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        // If key is not fully correct ..break
-        if (matchedBits < testKeySize)
-            break;
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->index);
 
-        // Set child as current node and move key position
-        node = testNode;
-        keyPos += matchedBits;
-    }
+    uint64_t hash = keyHash((unsigned char *)indexKey + sizeof(IndexKey), indexKey->keyBits);
 
-    return result;
+    entryRemove(entries, meta->indexSlots, &meta->indexCount, hash, (unsigned char *)indexKey - radix->memory);
 }
 
-RadixMatch radixMatchFirstNullable(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+static inline Item *dedupFind(Radix *radix, unsigned char *data, size_t dataSize, uint64_t hash)
 {
-    Radix *radix = iterator->radix;
-
     Meta *meta = (Meta *)radix->memory;
 
-    RadixMatch result = {0};
-
-    result.radix = radix;
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->dedup);
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    // Linear probing until an empty entry (entry key stores the item with the data)
+    for (size_t slot = hash & (meta->dedupSlots - 1); entries[slot].key != 0; slot = (slot + 1) & (meta->dedupSlots - 1)) {
+        if (entries[slot].hash != hash)
+            continue;
 
-    // If node is null, this means we should start with the head-node
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+        Item *item = (Item *) (radix->memory + entries[slot].key);
 
-        node = (Node *) (radix->memory + sizeof(Meta));
+        if (itemSize(item) == dataSize && keyEqual(data, itemStorage(item), dataSize * CHAR_BIT))
+            return item;
     }
 
-    for (size_t keyPos = 0; true;) {
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    return NULL;
+}
 
-        // If matched node has item (nullable) - update match and break
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.matchedBits = keyPos;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+static inline void dedupAdd(Radix *radix, Item *item, uint64_t hash)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-            break;
-        }
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->dedup);
 
-        // If keyPos has reached the size of the given key - break
-        if (keyBits <= keyPos)
-            break;
+    // If the table is full, the data of following items is just not shared
+    entryAdd(entries, meta->dedupSlots, &meta->dedupCount, hash, (unsigned char *)item - radix->memory);
+}
 
-        // Get direction of iteration
-        bool direction = bitGet(key, keyPos);
+static inline void dedupRemove(Radix *radix, Item *item)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        // Iterate..
-        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->dedup);
 
-        // If there is no child ..break
-        if (childAddress == 0)
-            break;
+    uint64_t hash = keyHash(itemStorage(item), itemSize(item) * CHAR_BIT);
 
-        // Check if the key is correct
-        Node *testNode = (Node *) (radix->memory + childAddress);
+    // The data may not have been added (table was full or the same data was already added)
+    entryRemove(entries, meta->dedupSlots, &meta->dedupCount, hash, (unsigned char *)item - radix->memory);
+}
 
-        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+// Returns the size of key bytes stored right after the node (in bits)
+static inline size_t nodeFragmentBits(Radix *radix, Node *node)
+{
+    size_t fragment = (unsigned char *)node - radix->memory + sizeof(Node);
 
-        size_t testKeyFore = testNode->keyForeOffset;
-        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+    return CHAR_BIT * (node->keyRear - fragment) + node->keyRearOffset;
+}
 
-        size_t testKeySize = testKeyRear - testKeyFore;
+static inline Node *fragmentFind(Radix *radix, unsigned char *fragment, size_t fragmentBits, uint64_t hash)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        // Compare key with testKey
-        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->fragment);
 
-        // If key is not fully correct ..break
-        if (matchedBits < testKeySize)
-            break;
+    // Linear probing until an empty entry (entry key stores the node with the key bytes)
+    for (size_t slot = hash & (meta->fragmentSlots - 1); entries[slot].key != 0; slot = (slot + 1) & (meta->fragmentSlots - 1)) {
+        if (entries[slot].hash != hash)
+            continue;
 
-        // Set child as current node and move key position
-        node = testNode;
-        keyPos += matchedBits;
+        Node *node = (Node *) (radix->memory + entries[slot].key);
+
+        if (nodeFragmentBits(radix, node) == fragmentBits && keyEqual(fragment, (unsigned char *)node + sizeof(Node), fragmentBits))
+            return node;
     }
 
-    return result;
+    return NULL;
 }
 
-RadixMatch radixMatchLongest(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+static inline void fragmentAdd(Radix *radix, Node *node, uint64_t hash)
 {
-    Radix *radix = iterator->radix;
-
     Meta *meta = (Meta *)radix->memory;
 
-    RadixMatch result = {0};
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->fragment);
 
-    result.radix = radix;
+    // If the table is full, the key bytes of following nodes are just not shared
+    entryAdd(entries, meta->fragmentSlots, &meta->fragmentCount, hash, (unsigned char *)node - radix->memory);
+}
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+static inline void fragmentRemove(Radix *radix, Node *node)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-    // If node is null, this means we should start with the head-node
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0) return result;
+    IndexEntry *entries = (IndexEntry *) (radix->memory + meta->fragment);
 
-        node = (Node *) (radix->memory + sizeof(Meta));
-    }
+    uint64_t hash = keyHash((unsigned char *)node + sizeof(Node), nodeFragmentBits(radix, node));
 
-    for (size_t keyPos = 0; true;) {
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    entryRemove(entries, meta->fragmentSlots, &meta->fragmentCount, hash, (unsigned char *)node - radix->memory);
+}
 
-        // If matched node has item (not nullable) - update match and continue
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.matchedBits = keyPos;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
-        }
+static inline void timeAdd(Radix *radix, Item *item)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        // If keyPos has reached the size of the given key - break
-        if (keyBits <= keyPos)
-            break;
+    TimeEntry *entries = (TimeEntry *) (radix->memory + meta->time);
 
-        // Get direction of iteration
-        bool direction = bitGet(key, keyPos);
+    // Full index keeps every other entry (starting from the earliest one) and doubles the stride
+    if (meta->timeCount == meta->timeSlots) {
+        for (size_t i = 0; i < meta->timeCount; i += 2) {
+            entries[i / 2] = entries[i];
+        }
 
-        // Iterate..
-        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+        meta->timeCount = (meta->timeCount + 1) / 2;
+        meta->timeStride *= 2;
+    }
 
-        // If there is no child ..break
-        if (childAddress == 0)
-            break;
+    uint64_t time = clockTime(radix);
 
-        // Check if the key is correct
-        Node *testNode = (Node *) (radix->memory + childAddress);
+    // Times are searched by the binary search, so they never decrease
+    if (meta->timeCount != 0 && time < entries[meta->timeCount - 1].time)
+        time = entries[meta->timeCount - 1].time;
 
-        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+    entries[meta->timeCount++] = (TimeEntry) {
+        .item = (unsigned char *)item - radix->memory,
+        .state = meta->structureEnd,
+        .time = time,
+    };
 
-        size_t testKeyFore = testNode->keyForeOffset;
-        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+    meta->timeSkipped = 0;
+}
 
-        size_t testKeySize = testKeyRear - testKeyFore;
+// Returns the item of the first time index entry at the address or after it
+// (the latest item if there is no such entry), items before the address are reached by the walk back from it
+static inline Item *timeFind(Radix *radix, size_t address)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        // Compare key with testKey
-        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+    TimeEntry *entries = (TimeEntry *) (radix->memory + meta->time);
 
-        // If key is not fully correct ..break
-        if (matchedBits < testKeySize)
-            break;
+    size_t fore = 0;
+    size_t rear = meta->time != 0 ? meta->timeCount : 0;
 
-        // Set child as current node and move key position
-        node = testNode;
-        keyPos += matchedBits;
+    while (fore < rear) {
+        size_t middle = fore + (rear - fore) / 2;
+
+        if (entries[middle].item < address)
+            fore = middle + 1;
+        else
+            rear = middle;
     }
 
-    return result;
+    size_t itemAddress = fore < (meta->time != 0 ? meta->timeCount : 0) ? entries[fore].item : meta->lastItem;
+
+    return itemAddress != 0 ? (Item *) (radix->memory + itemAddress) : NULL;
 }
 
-RadixMatch radixMatchLongestNullable(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+static inline void expirySwap(ExpiryEntry *entries, size_t a, size_t b)
 {
-    Radix *radix = iterator->radix;
+    ExpiryEntry entry = entries[a];
 
-    Meta *meta = (Meta *)radix->memory;
+    entries[a] = entries[b];
+    entries[b] = entry;
+}
 
-    RadixMatch result = {0};
+static inline void expirySiftDown(ExpiryEntry *entries, size_t index, size_t count)
+{
+    while (true) {
+        size_t smallest = index;
 
-    result.radix = radix;
+        for (size_t child = 2 * index + 1; child <= 2 * index + 2 && child < count; child++) {
+            if (entries[child].expires < entries[smallest].expires)
+                smallest = child;
+        }
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+        if (smallest == index)
+            return;
 
-    // If node is null, this means we should start with the head-node
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+        expirySwap(entries, index, smallest);
 
-        node = (Node *) (radix->memory + sizeof(Meta));
+        index = smallest;
     }
+}
 
-    for (size_t keyPos = 0; true;) {
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+static inline bool expiryPush(Radix *radix, uint64_t expires, size_t item)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        // If matched node has item (nullable) - update match and continue
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.matchedBits = keyPos;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
-        }
+    ExpiryEntry *entries = (ExpiryEntry *) (radix->memory + meta->expiry);
 
-        // If keyPos has reached the size of the given key - break
-        if (keyBits <= keyPos)
-            break;
+    if (meta->expiryCount == meta->expirySlots)
+        return false;
 
-        // Get direction of iteration
-        bool direction = bitGet(key, keyPos);
+    size_t index = meta->expiryCount++;
 
-        // Iterate..
-        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+    entries[index] = (ExpiryEntry) { .expires = expires, .item = item };
 
-        // If there is no child ..break
-        if (childAddress == 0)
-            break;
+    // Sift up (the earliest expiry is the root of the heap)
+    for (; index != 0 && entries[(index - 1) / 2].expires > entries[index].expires; index = (index - 1) / 2) {
+        expirySwap(entries, index, (index - 1) / 2);
+    }
 
-        // Check if the key is correct
-        Node *testNode = (Node *) (radix->memory + childAddress);
+    return true;
+}
 
-        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+static inline uint64_t *filterBlock(Radix *radix, uint64_t hash)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        size_t testKeyFore = testNode->keyForeOffset;
-        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+    // Block (cache line) is selected by the upper half of the hash
+    size_t block = ((hash >> 32) * meta->filterBlocks) >> 32;
 
-        size_t testKeySize = testKeyRear - testKeyFore;
+    return (uint64_t *) (radix->memory + meta->filter + block * RADIX_FILTER_BLOCK_SIZE);
+}
 
-        // Compare key with testKey
-        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+static inline void filterAdd(Radix *radix, uint64_t hash)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        // If key is not fully correct ..break
-        if (matchedBits < testKeySize)
-            break;
+    uint64_t *block = filterBlock(radix, hash);
 
-        // Set child as current node and move key position
-        node = testNode;
-        keyPos += matchedBits;
+    // Bits in the block are selected by the following 9-bit parts of the lower half of the hash
+    for (size_t i = 0; i < RADIX_FILTER_PROBES; i++) {
+        size_t bit = (hash >> (9 * i)) & 511;
+
+        block[bit / 64] |= (uint64_t)1 << (bit % 64);
     }
 
-    return result;
+    meta->filterKeys++;
 }
 
-RadixIterator radixMatchToIterator(RadixMatch *match)
+static inline bool filterContains(Radix *radix, uint64_t hash)
 {
-    return (RadixIterator) {
-        .radix = match->radix,
-        .node = match->node,
-        .data = match->data,
-        .dataSize = match->dataSize,
-    };
+    uint64_t *block = filterBlock(radix, hash);
+
+    for (size_t i = 0; i < RADIX_FILTER_PROBES; i++) {
+        size_t bit = (hash >> (9 * i)) & 511;
+
+        if ((block[bit / 64] & ((uint64_t)1 << (bit % 64))) == 0)
+            return false;
+    }
+
+    return true;
 }
 
-bool radixMatchIsEmpty(RadixMatch *match)
+Radix radixCreate(unsigned char *memory, size_t memorySize)
 {
-    return match->node == 0;
+#ifdef RADIX_COMPACT
+    if (memorySize > (Offset)-1)
+        memorySize = (Offset)-1;
+#endif
+
+    return (Radix){
+        .memory = memory,
+        .memorySize = memorySize,
+    };
 }
 
-RadixIterator radixPredecessor(RadixIterator *iterator)
+Radix radixCreateValueLog(unsigned char *memory, size_t memorySize, unsigned char *valueLog, size_t valueLogSize)
 {
-    Radix *radix = iterator->radix;
+    Radix radix = radixCreate(memory, memorySize);
 
-    RadixIterator result = {0};
+    radix.valueLog = valueLog;
+    radix.valueLogSize = valueLogSize;
 
-    result.radix = radix;
+    return radix;
+}
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+void radixSetClock(Radix *radix, RadixClock clock, void *clockContext)
+{
+    radix->clock = clock;
+    radix->clockContext = clockContext;
+}
 
-    // If node is null, return null
-    if (!node)
-        return result;
+RadixIterator radixIterator(Radix *radix)
+{
+    return (RadixIterator){
+        .radix = radix,
+        .node = 0,
+        .data = NULL,
+        .dataSize = 0,
+    };
+}
 
-    while (true) {
-        node = node->parent != 0 ? (Node *)(radix->memory + node->parent) : NULL;
+RadixValue radixValueIterator(Radix *radix)
+{
+    return (RadixValue){
+        .radix = radix,
+        .item = 0,
+        .data = NULL,
+        .dataSize = 0,
+    };
+}
 
-        if (!node)
-            return result;
+static inline size_t nodePadding(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        Item *item = node->item != 0 ? (Item *)(radix->memory + node->item) : NULL;
+    if (!meta->alignNodes)
+        return 0;
 
-        // If matched node has item (not nullable) - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    // Node is moved to the next cache line if it would straddle two of them
+    // (lines are counted from the memory start, so copies of the memory keep the alignment)
+    size_t lineOffset = meta->structureEnd % RADIX_CACHE_LINE_SIZE;
 
-            return result;
-        }
+    return lineOffset + sizeof(Node) > RADIX_CACHE_LINE_SIZE ? RADIX_CACHE_LINE_SIZE - lineOffset : 0;
+}
+
+// Returns the smallest size class of the block with the given payload (RADIX_CACHE_CLASSES - too large)
+static inline size_t cacheClass(size_t size)
+{
+    size_t sizeClass = 0;
+
+    while (sizeClass < RADIX_CACHE_CLASSES && ((size_t)RADIX_CACHE_BLOCK_SIZE << sizeClass) < sizeof(CacheBlock) + size) {
+        sizeClass++;
     }
+
+    return sizeClass;
 }
 
-RadixIterator radixPredecessorNullable(RadixIterator *iterator)
+static inline CacheFree *cacheFreeLinks(Radix *radix, size_t block)
 {
-    Radix *radix = iterator->radix;
+    return (CacheFree *) (radix->memory + block + sizeof(CacheBlock));
+}
 
-    RadixIterator result = {0};
+static inline void cachePush(Radix *radix, size_t block, size_t sizeClass)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-    result.radix = radix;
+    *(CacheBlock *) (radix->memory + block) = (CacheBlock) {
+        .sizeClass = sizeClass,
+        .kind = CACHE_FREE,
+    };
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    *cacheFreeLinks(radix, block) = (CacheFree) {
+        .next = meta->cacheFree[sizeClass],
+        .previous = 0,
+    };
 
-    // If node is null, return null
-    if (!node)
-        return result;
+    if (meta->cacheFree[sizeClass] != 0)
+        cacheFreeLinks(radix, meta->cacheFree[sizeClass])->previous = block;
 
-    // Move to predecessor
-    while (true) {
-        node = node->parent != 0 ? (Node *)(radix->memory + node->parent) : NULL;
+    meta->cacheFree[sizeClass] = block;
+}
 
-        if (!node)
-            return result;
+static inline void cacheUnlink(Radix *radix, size_t block)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-        Item *item = node->item != 0 ? (Item *)(radix->memory + node->item) : NULL;
+    CacheFree *links = cacheFreeLinks(radix, block);
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    if (links->previous != 0)
+        cacheFreeLinks(radix, links->previous)->next = links->next;
+    else
+        meta->cacheFree[((CacheBlock *) (radix->memory + block))->sizeClass] = links->next;
 
-            return result;
-        }
-    }
+    if (links->next != 0)
+        cacheFreeLinks(radix, links->next)->previous = links->previous;
 }
 
-RadixIterator radixPrev(RadixIterator *iterator)
+// Releases the block of the node or item (merged with its free buddies)
+static void cacheRelease(Radix *radix, size_t address)
 {
-    Radix *radix = iterator->radix;
-
     Meta *meta = (Meta *)radix->memory;
 
-    RadixIterator result = {0};
+    size_t block = address - sizeof(CacheBlock);
+    size_t sizeClass = ((CacheBlock *) (radix->memory + block))->sizeClass;
 
-    result.radix = radix;
+    while (sizeClass + 1 < RADIX_CACHE_CLASSES) {
+        size_t blockSize = (size_t)RADIX_CACHE_BLOCK_SIZE << sizeClass;
+        size_t buddy = meta->cache + ((block - meta->cache) ^ blockSize);
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+        if (buddy + blockSize > meta->structureEnd)
+            break;
 
-    // If node is null, this means we should start with the greatest leaf of all nodes
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+        CacheBlock *buddyHeader = (CacheBlock *) (radix->memory + buddy);
 
-        // Retrieve head-node
-        node = (Node *) (radix->memory + sizeof(Meta));
+        if (buddyHeader->kind != CACHE_FREE || buddyHeader->sizeClass != sizeClass)
+            break;
 
-        // Move to the greatest leaf-node of given node
-        while (node->childSmaller != 0 || node->childGreater != 0) {
-            node = (Node *) (radix->memory + (node->childGreater != 0 ? node->childGreater : node->childSmaller));
-        }
+        cacheUnlink(radix, buddy);
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+        block = buddy < block ? buddy : block;
+        sizeClass++;
+    }
 
-        // If matched node has item (not nullable) - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    // The CLOCK hand must stay at the block boundary
+    if (meta->cacheHand > block && meta->cacheHand < block + ((size_t)RADIX_CACHE_BLOCK_SIZE << sizeClass))
+        meta->cacheHand = block;
 
-            return result;
+    cachePush(radix, block, sizeClass);
+}
+
+// Returns the address of the block payload (0 - out of the cache memory)
+static size_t cacheAllocate(Radix *radix, size_t size, CacheKind kind)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    size_t sizeClass = cacheClass(size);
+
+    if (sizeClass == RADIX_CACHE_CLASSES)
+        return 0;
+
+    size_t block = 0;
+
+    // Take the smallest free block, the larger one is split to halves
+    for (size_t freeClass = sizeClass; freeClass < RADIX_CACHE_CLASSES; freeClass++) {
+        if (meta->cacheFree[freeClass] == 0)
+            continue;
+
+        block = meta->cacheFree[freeClass];
+
+        cacheUnlink(radix, block);
+
+        while (freeClass > sizeClass) {
+            freeClass--;
+
+            cachePush(radix, block + ((size_t)RADIX_CACHE_BLOCK_SIZE << freeClass), freeClass);
         }
+
+        break;
     }
 
-    // Move to smaller (shorter < longer)
-    // Priority:
-    // 1: parent-child-child (leaf child)
-    // 2: parent-child
-    // 3: parent
-    //   no parent - return empty iterator
-    while (true) {
-        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    // Otherwise take the block from the unused memory (aligned to its size, the gap is released)
+    if (block == 0) {
+        size_t blockSize = (size_t)RADIX_CACHE_BLOCK_SIZE << sizeClass;
+        size_t aligned = meta->cache + (meta->structureEnd - meta->cache + blockSize - 1) / blockSize * blockSize;
 
-        // "no parent"
-        if (!parentNode)
-            return result;
+        if (aligned > meta->cacheEnd || blockSize > meta->cacheEnd - aligned)
+            return 0;
 
-        if (parentNode->childSmaller != 0 && parentNode->childSmaller != (unsigned char*)node - radix->memory) {
-            node = (Node *) (radix->memory + parentNode->childSmaller);
+        while (meta->structureEnd < aligned) {
+            size_t gapClass = 0;
 
-            // Move to "parent-child-child" or "parent-child"
-            while (node->childSmaller != 0 || node->childGreater != 0) {
-                node = (Node *) (radix->memory + (node->childGreater != 0 ? node->childGreater : node->childSmaller));
+            while (gapClass + 1 < sizeClass && (meta->structureEnd - meta->cache) % ((size_t)RADIX_CACHE_BLOCK_SIZE << (gapClass + 1)) == 0) {
+                gapClass++;
             }
-        } else {
-            // Move to "parent"
-            node = parentNode;
-        }
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+            size_t gap = meta->structureEnd;
 
-        // If matched node has item not (nullable) - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+            *(CacheBlock *) (radix->memory + gap) = (CacheBlock) { .sizeClass = gapClass };
 
-            return result;
+            meta->structureEnd += (size_t)RADIX_CACHE_BLOCK_SIZE << gapClass;
+
+            cacheRelease(radix, gap + sizeof(CacheBlock));
         }
+
+        block = aligned;
+
+        meta->structureEnd = aligned + blockSize;
     }
+
+    *(CacheBlock *) (radix->memory + block) = (CacheBlock) {
+        .sizeClass = sizeClass,
+        .kind = kind,
+        .referenced = 0,
+    };
+
+    return block + sizeof(CacheBlock);
 }
 
-RadixIterator radixPrevNullable(RadixIterator *iterator)
+// Sets the CLOCK reference bit, so the matched key gets the second chance before eviction
+static inline void cacheTouch(Radix *radix, Item *item)
 {
-    Radix *radix = iterator->radix;
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->cache != 0)
+        ((CacheBlock *) ((unsigned char *)item - sizeof(CacheBlock)))->referenced = 1;
+}
 
+// Releases nodes left without items and children, from the node up to the pinned one
+static void cachePrune(Radix *radix, Node *node, Node *pinned)
+{
     Meta *meta = (Meta *)radix->memory;
 
-    RadixIterator result = {0};
+    Node *head = (Node *) (radix->memory + sizeof(Meta));
 
-    result.radix = radix;
+    while (node != head && node != pinned && node->item == 0 && node->childSmaller == 0 && node->childGreater == 0) {
+        size_t nodeAddress = (unsigned char *)node - radix->memory;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+        Node *parent = (Node *) (radix->memory + node->parent);
 
-    // If node is null, this means we should start with the greatest leaf of all nodes
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+        if (parent->childSmaller == nodeAddress)
+            parent->childSmaller = 0;
+        else
+            parent->childGreater = 0;
 
-        // Retrieve head-node
-        node = (Node *) (radix->memory + sizeof(Meta));
+        meta->nodeCount--;
+        meta->keyBytes -= nodeKeyMemory(radix, node);
+
+        cacheRelease(radix, nodeAddress);
+
+        node = parent;
+    }
+
+    liveUpdate(radix, node);
+}
+
+// Evicts the key whose item is not referenced since the last pass of the CLOCK hand
+// (if all visited items are referenced, the first of them is evicted)
+static bool cacheEvict(Radix *radix, Node *pinned)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    size_t victim = 0;
+    size_t candidate = 0;
+
+    for (size_t step = 0; step < RADIX_CACHE_CLOCK_STEPS; step++) {
+        if (meta->cacheHand >= meta->structureEnd)
+            meta->cacheHand = meta->cache;
+
+        if (meta->cacheHand >= meta->structureEnd)
+            break;
+
+        size_t block = meta->cacheHand;
+
+        CacheBlock *header = (CacheBlock *) (radix->memory + block);
+
+        meta->cacheHand += (size_t)RADIX_CACHE_BLOCK_SIZE << header->sizeClass;
+
+        if (header->kind != CACHE_ITEM)
+            continue;
+
+        if (header->referenced) {
+            header->referenced = 0;
+
+            if (candidate == 0)
+                candidate = block;
+
+            continue;
+        }
+
+        victim = block;
+        break;
+    }
+
+    if (victim == 0)
+        victim = candidate;
+
+    if (victim == 0)
+        return false;
+
+    Item *item = (Item *) (radix->memory + victim + sizeof(CacheBlock));
+    Node *node = (Node *) (radix->memory + item->node);
+
+    statsItemRemove(meta, item, NULL);
+
+    itemRelease(item);
+
+    node->item = 0;
+
+    cacheRelease(radix, victim + sizeof(CacheBlock));
+
+    meta->cacheEvictions++;
+
+    cachePrune(radix, node, pinned);
+
+    return true;
+}
+
+static RadixValue cacheInsertBlocks(Radix *radix, Node *start, unsigned char *key, size_t keyPos, size_t keyBits, ItemKind kind, unsigned char *storage, size_t storageSize, size_t dataSize)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    Node *node = start;
+
+    // Insert node - iterate thought structure and create new edge-nodes (every node stores its own key part)
+    for (; keyPos < keyBits;) {
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        Offset *nodeChild = direction ? &(node->childGreater) : &(node->childSmaller);
+
+        // If there is no child ..create it and end iteration
+        if (*nodeChild == 0) {
+            size_t nodeAddress = cacheAllocate(radix, sizeof(Node) + ((keyBits - keyPos + CHAR_BIT - 1) / CHAR_BIT), CACHE_NODE);
+
+            if (nodeAddress == 0)
+                return result;
+
+            Node *newNode = (Node *) (radix->memory + nodeAddress);
+            unsigned char *newKey = (unsigned char *) newNode + sizeof(Node);
+
+            *newNode = (Node) {
+                .parent = (unsigned char *)node - radix->memory,
+                .keyFore = newKey - radix->memory,
+                .keyRear = newKey - radix->memory + ((keyBits - keyPos) / CHAR_BIT),
+                .keyForeOffset = 0,
+                .keyRearOffset = ((keyBits - keyPos) % CHAR_BIT),
+            };
+
+            bitCopy(key, keyPos, newKey, 0, keyBits - keyPos);
+
+            *nodeChild = nodeAddress;
+
+            meta->nodeCount++;
+            meta->keyBytes += nodeKeyMemory(radix, newNode);
+
+            node = newNode;
+            break;
+        }
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + *nodeChild);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // If key is not fully maching ..split this node (the split node copies the matched key part)
+        if (matchedBits < testKeyRear - testKeyFore) {
+            size_t nodeAddress = cacheAllocate(radix, sizeof(Node) + ((matchedBits + CHAR_BIT - 1) / CHAR_BIT), CACHE_NODE);
+
+            if (nodeAddress == 0)
+                return result;
+
+            Node *newNode = (Node *) (radix->memory + nodeAddress);
+            unsigned char *newKey = (unsigned char *) newNode + sizeof(Node);
+
+            bool splitDirection = bitGet(testKey, testKeyFore + matchedBits);
+
+            bitCopy(testKey, testKeyFore, newKey, 0, matchedBits);
+
+            *newNode = (Node) {
+                .parent = testNode->parent,
+                .childSmaller = splitDirection ? 0 : *nodeChild,
+                .childGreater = splitDirection ? *nodeChild : 0,
+                .keyFore = newKey - radix->memory,
+                .keyRear = newKey - radix->memory + (matchedBits / CHAR_BIT),
+                .keyForeOffset = 0,
+                .keyRearOffset = matchedBits % CHAR_BIT,
+                .live = testNode->live,
+            };
+
+            // Update splited node
+            testNode->parent = nodeAddress;
+            testNode->keyFore += (testKeyFore + matchedBits) / CHAR_BIT;
+            testNode->keyForeOffset = (testKeyFore + matchedBits) % CHAR_BIT;
+
+            *nodeChild = nodeAddress;
+
+            meta->nodeCount++;
+            meta->keyBytes += nodeKeyMemory(radix, newNode);
+
+            testNode = newNode;
+        }
+
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    // Insert item - it replaces the item of the node (rewritten in place if it needs the same block)
+    Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+    size_t neededMemory = sizeof(Item) + storageSize;
+    size_t itemAddress = node->item;
+
+    if (item && cacheClass(neededMemory) == ((CacheBlock *) ((unsigned char *)item - sizeof(CacheBlock)))->sizeClass) {
+        statsItemRemove(meta, item, NULL);
+
+        itemRelease(item);
+
+        item = NULL;
+    } else {
+        itemAddress = cacheAllocate(radix, neededMemory, CACHE_ITEM);
+
+        // Node created for the item is released
+        if (itemAddress == 0) {
+            cachePrune(radix, node, start);
+
+            return result;
+        }
+    }
+
+    Item *newItem = (Item *) (radix->memory + itemAddress);
+
+    *newItem = (Item) {
+        .size = dataSize | (Offset)kind << ITEM_KIND_SHIFT,
+        .node = (unsigned char *)node - radix->memory,
+        .previous = 0,
+        .lastItem = 0,
+    };
+
+    byteCopy(itemStorage(newItem), storage, storageSize);
+
+    // Replaced item is released after the data is copied (it may be the source of the data)
+    if (item) {
+        statsItemRemove(meta, item, NULL);
+
+        itemRelease(item);
+
+        cacheRelease(radix, node->item);
+    }
+
+    statsItemAdd(meta, newItem, NULL);
+
+    node->item = itemAddress;
+
+    liveUpdate(radix, node);
+
+    result.item = itemAddress;
+    result.data = itemData(radix, newItem);
+    result.dataSize = dataSize;
+
+    return result;
+}
+
+static RadixValue cacheInsert(Radix *radix, Node *start, unsigned char *key, size_t keyPos, size_t keyBits, ItemKind kind, unsigned char *storage, size_t storageSize, size_t dataSize)
+{
+    // Full cache evicts keys until the insert fits (the descent is repeated, evicted nodes may be on its path)
+    for (size_t evictions = 0; true; evictions++) {
+        RadixValue result = cacheInsertBlocks(radix, start, key, keyPos, keyBits, kind, storage, storageSize, dataSize);
+
+        if (!radixValueIsEmpty(&result) || evictions == RADIX_CACHE_EVICTIONS || !cacheEvict(radix, start))
+            return result;
+    }
+}
+
+// Deletes the key physically (its item and the nodes left without items and children are released)
+static RadixValue cacheRemove(Radix *radix, Node *start, unsigned char *key, size_t keyPos, size_t keyBits)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    Node *node = start;
+
+    while (keyPos < keyBits) {
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..there is no key
+        if (childAddress == 0)
+            return result;
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        if (matchedBits < testKeyRear - testKeyFore)
+            return result;
+
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    if (node->item == 0)
+        return result;
+
+    Item *item = (Item *) (radix->memory + node->item);
+
+    statsItemRemove(meta, item, NULL);
+
+    itemRelease(item);
+
+    cacheRelease(radix, node->item);
+
+    node->item = 0;
+
+    cachePrune(radix, node, start);
+
+    return result;
+}
+
+static RadixValue insert(Radix *radix, Node *node, unsigned char *key, size_t keyPos, size_t keyBits, ItemKind kind, unsigned char *storage, size_t storageSize, size_t dataSize, uint64_t expires)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Data size must not overlap the item kind bits, frozen structure is read-only
+    if (dataSize > ITEM_SIZE_MASK || meta->frozen)
+        return result;
+
+    // Cache mode reuses the blocks of replaced, removed and evicted keys
+    if (meta->cache != 0) {
+        if (dataSize == 0)
+            return cacheRemove(radix, node, key, keyPos, keyBits);
+
+        return cacheInsert(radix, node, key, keyPos, keyBits, kind, storage, storageSize, dataSize);
+    }
+
+    // Insert node - iterate thought structure and create new edge-nodes
+    for (; keyPos < keyBits;) {
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        // Iterate..
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..create it and end iteration
+        if (childAddress == 0) {
+            // Calculate needed memory (aligned node is placed after the padding)
+            size_t padding = nodePadding(radix);
+            size_t neededMemory = padding + sizeof(Node) + ((keyBits - keyPos + CHAR_BIT - 1) / CHAR_BIT);
+
+            // Check free memory
+            if (neededMemory > radix->memorySize - meta->structureEnd) {
+                return result;
+            }
+
+            // Compose memory
+            Node *newNode = (Node*) (radix->memory + meta->structureEnd + padding);
+            unsigned char *newKey = (unsigned char *) newNode + sizeof(Node);
+
+            // Write node
+            *newNode = (Node) {
+                .parent = (unsigned char *)node - radix->memory,
+                .childSmaller = 0,
+                .childGreater = 0,
+                .keyFore = newKey - radix->memory,
+                .keyRear = newKey - radix->memory + ((keyBits - keyPos) / CHAR_BIT),
+                .keyForeOffset = 0,
+                .keyRearOffset = ((keyBits - keyPos) % CHAR_BIT),
+                .lastNode = meta->lastNode,
+                .item = 0,
+            };
+
+            // Write key
+            bitCopy(key, keyPos, newKey, 0, keyBits - keyPos);
+
+            // The same key fragment may be stored already ..point the node to it instead
+            if (meta->fragment != 0 && keyBits - keyPos >= RADIX_FRAGMENT_MIN_SIZE * CHAR_BIT) {
+                uint64_t hash = keyHash(newKey, keyBits - keyPos);
+
+                Node *fragmentNode = fragmentFind(radix, newKey, keyBits - keyPos, hash);
+
+                if (fragmentNode) {
+                    newNode->keyFore = (unsigned char *)fragmentNode - radix->memory + sizeof(Node);
+                    newNode->keyRear = newNode->keyFore + ((keyBits - keyPos) / CHAR_BIT);
+
+                    neededMemory = padding + sizeof(Node);
+                } else {
+                    fragmentAdd(radix, newNode, hash);
+                }
+            }
+
+            // Set new node as node child
+            Offset *nodeChild = direction ? &(node->childGreater) : &(node->childSmaller);
+
+            *nodeChild = (unsigned char *)newNode - radix->memory;
+
+            // Update meta information
+            meta->lastNode = (unsigned char *)newNode - radix->memory;
+            meta->structureEnd += neededMemory;
+            meta->nodeCount++;
+            meta->keyBytes += nodeKeyMemory(radix, newNode);
+
+            // Assign new node as current node
+            node = newNode;
+
+            break;
+        }
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t testKeyBits = testKeyRear - testKeyFore;
+
+        // Compare key with testKey
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // If key is not fully maching ..split this node and continue iteration
+        if (matchedBits < testKeyBits) {
+            // Calculate needed memory (aligned node is placed after the padding)
+            size_t padding = nodePadding(radix);
+            size_t neededMemory = padding + sizeof(Node);
+
+            // Check free memory
+            if (neededMemory > radix->memorySize - meta->structureEnd) {
+                return result;
+            }
+
+            // Compose memory
+            Node *newNode = (Node *) (radix->memory + meta->structureEnd + padding);
+
+            // Get split direction
+            bool splitDirection = bitGet(
+                (unsigned char *) (radix->memory + testNode->keyFore),
+                testNode->keyForeOffset + matchedBits
+            );
+
+            // Write split node
+            *newNode = (Node) {
+                .parent = testNode->parent,
+                .childSmaller = splitDirection ? 0 : (unsigned char *)testNode - radix->memory,
+                .childGreater = splitDirection ? (unsigned char *)testNode - radix->memory : 0,
+                .keyFore = testNode->keyFore,
+                .keyRear = testNode->keyFore + ((testNode->keyForeOffset + matchedBits) / CHAR_BIT),
+                .keyForeOffset = testNode->keyForeOffset,
+                .keyRearOffset = (testNode->keyForeOffset + matchedBits) % CHAR_BIT,
+                .live = testNode->live,
+                .lastNode = meta->lastNode,
+                .item = 0,
+            };
+
+            // Update splited node
+            testNode->parent = (unsigned char *)newNode - radix->memory;
+            testNode->keyFore = newNode->keyRear;
+            testNode->keyForeOffset = newNode->keyRearOffset;
+
+            // Set new node as node child
+            Offset *nodeChild = direction ? &(node->childGreater) : &(node->childSmaller);
+
+            *nodeChild = (unsigned char *)newNode - radix->memory;
+
+            // Update meta information
+            meta->lastNode = (unsigned char *)newNode - radix->memory;
+            meta->structureEnd += neededMemory;
+            meta->nodeCount++;
+
+            // Assign new node as fully maching node
+            testNode = newNode;
+        }
+
+        // key is fully correct, set testNode as node
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    // Insert item
+    // Node is matched, so add a new item to the structure
+    {
+        // If node gets its first item, its key is indexed and added to the filter
+        bool indexed = meta->index != 0 && node->item == 0;
+        bool filtered = meta->filter != 0 && node->item == 0;
+
+        RadixIterator nodeIterator = { .radix = radix, .node = (unsigned char *)node - radix->memory };
+
+        size_t nodeKeyBits = indexed || filtered ? radixKeyBits(&nodeIterator) : 0;
+
+        size_t keyMemory = indexed || filtered ? sizeof(IndexKey) + (nodeKeyBits + CHAR_BIT - 1) / CHAR_BIT : 0;
+
+        // Large data is appended to the value log, the item stores only its address
+        ItemLog log = { .offset = meta->valueLogEnd };
+        unsigned char *logData = NULL;
+
+        if (kind == ITEM_INLINE && meta->valueThreshold != 0 && dataSize >= meta->valueThreshold && radix->valueLog != NULL) {
+            if (dataSize > radix->valueLogSize - meta->valueLogEnd)
+                return result;
+
+            logData = storage;
+
+            kind = ITEM_LOG;
+            storage = (unsigned char *)&log;
+            storageSize = sizeof(ItemLog);
+        }
+
+        // Data identical to the data of an older inline item is shared with it
+        ItemShared shared = {0};
+        bool deduplicated = kind == ITEM_INLINE && meta->dedup != 0 && dataSize > sizeof(ItemShared);
+        uint64_t dataHash = deduplicated ? keyHash(storage, dataSize * CHAR_BIT) : 0;
+
+        if (deduplicated) {
+            Item *sharedItem = dedupFind(radix, storage, dataSize, dataHash);
+
+            if (sharedItem) {
+                shared.item = (unsigned char *)sharedItem - radix->memory;
+
+                kind = ITEM_SHARED;
+                storage = (unsigned char *)&shared;
+                storageSize = sizeof(ItemShared);
+            }
+        }
+
+        // Large data is compressed right into the free memory (it is kept only if it gets smaller)
+        ItemCompressed compressed = {0};
+        bool compressedInPlace = false;
+
+        // Expiry and version are written before the item
+        size_t prefixMemory = itemPrefixSize(meta);
+
+        if (kind == ITEM_INLINE && meta->compressThreshold != 0 && dataSize >= meta->compressThreshold) {
+            size_t compressedFore = meta->structureEnd + prefixMemory + sizeof(Item) + sizeof(ItemCompressed);
+
+            if (compressedFore < radix->memorySize) {
+                size_t compressedCapacity = radix->memorySize - compressedFore < dataSize - 1 ? radix->memorySize - compressedFore : dataSize - 1;
+
+                compressed.size = compress(storage, dataSize, radix->memory + compressedFore, compressedCapacity);
+
+                if (compressed.size != 0) {
+                    kind = ITEM_COMPRESSED;
+                    storage = (unsigned char *)&compressed;
+                    storageSize = sizeof(ItemCompressed) + compressed.size;
+
+                    compressedInPlace = true;
+                }
+            }
+        }
+
+        // Calculate needed memory
+        size_t neededMemory = prefixMemory + sizeof(Item) + storageSize;
+
+        // Check free memory (the key is copied after the data, but it stays there only if it is indexed)
+        if (neededMemory + keyMemory > radix->memorySize - meta->structureEnd) {
+            return result;
+        }
+
+        if (indexed)
+            neededMemory += keyMemory;
+
+        // Compose memory
+        Item *newItem = (Item *) (radix->memory + meta->structureEnd + prefixMemory);
+        unsigned char *newStorage = itemStorage(newItem);
+
+        // Write item
+        *newItem = (Item) {
+            .size = dataSize | (Offset)kind << ITEM_KIND_SHIFT,
+            .node = (unsigned char *)node - radix->memory,
+            .previous = node->item,
+            .lastItem = meta->lastItem,
+        };
+
+        // Write version - the skip pointer follows the skew-binary scheme,
+        // so any earlier version is reached by O(log versions) jumps
+        if (meta->versions) {
+            ItemVersion *version = itemVersion(newItem);
+
+            *version = (ItemVersion) {
+                .number = 1,
+                .jump = (unsigned char *)newItem - radix->memory,
+            };
+
+            if (node->item != 0) {
+                ItemVersion *previous = itemVersion((Item *) (radix->memory + node->item));
+                ItemVersion *jump = itemVersion((Item *) (radix->memory + previous->jump));
+                ItemVersion *jumpJump = itemVersion((Item *) (radix->memory + jump->jump));
+
+                version->number = previous->number + 1;
+                version->jump = previous->number - jump->number == jump->number - jumpJump->number ? jump->jump : node->item;
+            }
+        }
+
+        // Write expiry (items with null data never expire)
+        if (meta->expiry != 0) {
+            itemExpiry(meta, newItem)->expires = dataSize != 0 ? expires : 0;
+
+            if (dataSize != 0 && expires != 0 && !expiryPush(radix, expires, (unsigned char *)newItem - radix->memory))
+                meta->expiryOverflow = true;
+        }
+
+        // Write data (or its handle, data compressed in place is already there)
+        byteCopy(newStorage, storage, compressedInPlace ? sizeof(ItemCompressed) : storageSize);
+
+        if (logData) {
+            byteCopy(radix->valueLog + log.offset, logData, dataSize);
+
+            meta->valueLogEnd += dataSize;
+        }
+
+        if (deduplicated && kind == ITEM_INLINE)
+            dedupAdd(radix, newItem, dataHash);
+
+        // Write index key
+        if (indexed || filtered) {
+            IndexKey *newIndexKey = (IndexKey *) (newStorage + storageSize);
+
+            *newIndexKey = (IndexKey) {
+                .node = (unsigned char *)node - radix->memory,
+                .keyBits = nodeKeyBits,
+            };
+
+            radixKeyCopy(&nodeIterator, (unsigned char *)newIndexKey + sizeof(IndexKey), nodeKeyBits);
+
+            uint64_t hash = keyHash((unsigned char *)newIndexKey + sizeof(IndexKey), nodeKeyBits);
+
+            if (indexed)
+                indexAdd(radix, newIndexKey, hash);
+
+            if (filtered)
+                filterAdd(radix, hash);
+        }
+
+        // Update node
+        statsItemAdd(meta, newItem, node->item != 0 ? (Item *) (radix->memory + node->item) : NULL);
+
+        node->item = (unsigned char *)newItem - radix->memory;
+
+        liveUpdate(radix, node);
+
+        // Update meta information
+        meta->lastItem = (unsigned char *)newItem - radix->memory;
+        meta->structureEnd += neededMemory;
+
+        // Every stride-th item is added to the time index
+        if (meta->time != 0 && ++meta->timeSkipped >= meta->timeStride)
+            timeAdd(radix, newItem);
+
+        // Update result
+        result.item = (unsigned char *)newItem - radix->memory;
+        result.data = itemData(radix, newItem);
+        result.dataSize = dataSize;
+    }
+
+    return result;
+}
+
+static Node *insertStart(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // Frozen structure is read-only (it has no head-node, but it must not be initialized)
+    if (meta->frozen)
+        return NULL;
+
+    // If node is null, this means we should start with the head-node
+    if (!node) {
+        // If the structure has not been managed before, it may need to be initialized
+        if (meta->lastNode == 0) {
+            // Calculate needed memory
+            size_t neededMemory = sizeof(Meta) + sizeof(Node);
+
+            // Check free memory
+            if (neededMemory > radix->memorySize - meta->structureEnd)
+                return NULL;
+
+            // Compose memory
+            node = (Node *) (radix->memory + sizeof(Meta));
+
+            // Write head node
+            *node = (Node) {0};
+
+            // Write meta information
+            *meta = (Meta) {
+                .lastNode = (unsigned char *)node - radix->memory,
+                .lastItem = 0,
+                .structureEnd = neededMemory,
+                .nodeCount = 1,
+            };
+        }
+
+        node = (Node *) (radix->memory + sizeof(Meta));
+    }
+
+    return node;
+}
+
+RadixValue radixInsert(RadixIterator* iterator, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize)
+{
+    Node *node = insertStart(iterator);
+
+    if (!node)
+        return (RadixValue) { .radix = iterator->radix };
+
+    return insert(iterator->radix, node, key, 0, keyBits, ITEM_INLINE, data, dataSize, dataSize, 0);
+}
+
+RadixValue radixInsertReference(RadixIterator* iterator, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize, RadixReleaseCallback release, void *context)
+{
+    Node *node = insertStart(iterator);
+
+    if (!node)
+        return (RadixValue) { .radix = iterator->radix };
+
+    // Empty data is stored as null data
+    if (dataSize == 0)
+        return insert(iterator->radix, node, key, 0, keyBits, ITEM_INLINE, NULL, 0, 0, 0);
+
+    ItemReference reference = {
+        .data = data,
+        .release = release,
+        .context = context,
+    };
+
+    return insert(iterator->radix, node, key, 0, keyBits, ITEM_REFERENCE, (unsigned char *)&reference, sizeof(ItemReference), dataSize, 0);
+}
+
+RadixValue radixInsertExpiring(RadixIterator* iterator, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize, uint64_t expires)
+{
+    Node *node = insertStart(iterator);
+
+    if (!node)
+        return (RadixValue) { .radix = iterator->radix };
+
+    return insert(iterator->radix, node, key, 0, keyBits, ITEM_INLINE, data, dataSize, dataSize, expires);
+}
+
+size_t radixExpireStep(Radix *radix, size_t budget)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->expiry == 0 || meta->frozen)
+        return 0;
+
+    ExpiryEntry *entries = (ExpiryEntry *) (radix->memory + meta->expiry);
+
+    uint64_t time = clockTime(radix);
+
+    size_t expired = 0;
+
+    for (; budget > 0 && meta->expiryCount != 0 && entries[0].expires <= time; budget--) {
+        ExpiryEntry entry = entries[0];
+
+        // Pop the earliest expiry
+        entries[0] = entries[--meta->expiryCount];
+
+        expirySiftDown(entries, 0, meta->expiryCount);
+
+        Item *item = (Item *) (radix->memory + entry.item);
+        Node *node = (Node *) (radix->memory + item->node);
+
+        // Item replaced by the newer one is already shadowed
+        if (node->item != entry.item)
+            continue;
+
+        // Expired item is shadowed by null data
+        RadixValue value = insert(radix, node, NULL, 0, 0, ITEM_INLINE, NULL, 0, 0, 0);
+
+        if (radixValueIsEmpty(&value)) {
+            expiryPush(radix, entry.expires, entry.item);
+            break;
+        }
+
+        expired++;
+    }
+
+    return expired;
+}
+
+RadixValue radixRemove(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+{
+    return radixInsert(iterator, key, keyBits, NULL, 0);
+}
+
+// Reads the LEB128 number of the frozen record and moves the position after it
+static inline size_t frozenNumberRead(unsigned char *input, size_t *position)
+{
+    size_t value = 0;
+
+    for (size_t shift = 0; true; shift += 7) {
+        unsigned char byte = input[(*position)++];
+
+        value |= (size_t)(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+}
+
+// Writes the LEB128 number of the frozen record, returns its size
+static inline size_t frozenNumberWrite(unsigned char *output, size_t value)
+{
+    size_t size = 0;
+
+    do {
+        output[size++] = (unsigned char)((value & 0x7f) | (value >= 0x80 ? 0x80 : 0));
+
+        value >>= 7;
+    } while (value != 0);
+
+    return size;
+}
+
+static inline size_t frozenOffsetRead(unsigned char *input)
+{
+    size_t value = 0;
+
+    for (size_t i = 0; i < RADIX_FROZEN_OFFSET_SIZE; i++) {
+        value |= (size_t)input[i] << (CHAR_BIT * i);
+    }
+
+    return value;
+}
+
+static inline void frozenOffsetWrite(unsigned char *output, size_t value)
+{
+    for (size_t i = 0; i < RADIX_FROZEN_OFFSET_SIZE; i++) {
+        output[i] = (unsigned char)(value >> (CHAR_BIT * i));
+    }
+}
+
+static inline FrozenRecord frozenRecord(Radix *radix, size_t address)
+{
+    FrozenRecord record = { .address = address };
+
+    size_t position = address;
+
+    record.flags = radix->memory[position++];
+
+    // Greater child is stored after the smaller subtree (otherwise the only child follows the record)
+    size_t greaterOffset = 0;
+
+    if ((record.flags & FROZEN_SMALLER) && (record.flags & FROZEN_GREATER)) {
+        greaterOffset = frozenOffsetRead(radix->memory + position);
+        position += RADIX_FROZEN_OFFSET_SIZE;
+    }
+
+    record.keyBits = frozenNumberRead(radix->memory, &position);
+    record.key = radix->memory + position;
+    position += (record.keyBits + CHAR_BIT - 1) / CHAR_BIT;
+
+    if (record.flags & FROZEN_VALUE) {
+        record.dataSize = frozenNumberRead(radix->memory, &position);
+        record.data = radix->memory + position;
+        position += record.dataSize;
+    }
+
+    record.end = position;
+    record.childSmaller = (record.flags & FROZEN_SMALLER) ? position : 0;
+    record.childGreater = (record.flags & FROZEN_GREATER) ? (greaterOffset != 0 ? address + greaterOffset : position) : 0;
+
+    return record;
+}
+
+// Returns the child on the path to the record of its subtree (the smaller subtree ends at the greater child)
+static inline size_t frozenToward(FrozenRecord *record, size_t target)
+{
+    if (record->childSmaller != 0 && (record->childGreater == 0 || target < record->childGreater))
+        return record->childSmaller;
+
+    return record->childGreater;
+}
+
+static inline RadixIterator frozenIterator(Radix *radix, FrozenRecord *record)
+{
+    return (RadixIterator) {
+        .radix = radix,
+        .node = record->address,
+        .data = record->data,
+        .dataSize = record->dataSize,
+    };
+}
+
+// Matches the key in the frozen structure (all its values are visible, so nullable matches are the same)
+static RadixMatch frozenMatch(RadixIterator *iterator, unsigned char *key, size_t keyBits, FrozenMatch mode)
+{
+    Radix *radix = iterator->radix;
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    FrozenRecord record = frozenRecord(radix, iterator->node != 0 ? iterator->node : sizeof(Meta));
+
+    for (size_t keyPos = 0; true;) {
+        // Exact match takes only the whole key, the first and the longest matches take its prefixes too
+        if ((record.flags & FROZEN_VALUE) && (mode != FROZEN_MATCH_EXACT || keyPos >= keyBits)) {
+            result.node = record.address;
+            result.matchedBits = keyPos;
+            result.data = record.data;
+            result.dataSize = record.dataSize;
+
+            if (mode == FROZEN_MATCH_FIRST)
+                break;
+        }
+
+        if (keyPos >= keyBits)
+            break;
+
+        size_t childAddress = bitGet(key, keyPos) ? record.childGreater : record.childSmaller;
+
+        if (childAddress == 0)
+            break;
+
+        FrozenRecord child = frozenRecord(radix, childAddress);
+
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, child.key, 0, child.keyBits);
+
+        if (matchedBits < child.keyBits)
+            break;
+
+        record = child;
+        keyPos += matchedBits;
+    }
+
+    return result;
+}
+
+// Returns the deepest ancestor with a value
+static RadixIterator frozenPredecessor(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    RadixIterator result = { .radix = radix };
+
+    for (size_t address = iterator->node != 0 ? sizeof(Meta) : 0; address != 0 && address != iterator->node;) {
+        FrozenRecord record = frozenRecord(radix, address);
+
+        if (record.flags & FROZEN_VALUE)
+            result = frozenIterator(radix, &record);
+
+        address = frozenToward(&record, iterator->node);
+    }
+
+    return result;
+}
+
+// Returns the next value in the key order - records are stored in the key order,
+// so it is the next record with a value (leaves always have values)
+static RadixIterator frozenNext(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixIterator result = { .radix = radix };
+
+    size_t address = iterator->node != 0 ? frozenRecord(radix, iterator->node).end : sizeof(Meta);
+
+    while (address < meta->structureEnd) {
+        FrozenRecord record = frozenRecord(radix, address);
+
+        if (record.flags & FROZEN_VALUE)
+            return frozenIterator(radix, &record);
+
+        address = record.end;
+    }
+
+    return result;
+}
+
+// Returns the previous value in the key order - the deepest ancestor with a value or the last value
+// of the smaller subtree skipped by the path (the last value of all for the empty iterator)
+static RadixIterator frozenPrev(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    RadixIterator result = { .radix = radix };
+
+    size_t subtree = iterator->node != 0 ? 0 : sizeof(Meta);
+
+    for (size_t address = iterator->node != 0 ? sizeof(Meta) : 0; address != 0 && address != iterator->node;) {
+        FrozenRecord record = frozenRecord(radix, address);
+
+        address = frozenToward(&record, iterator->node);
+
+        if (address == record.childGreater && record.childSmaller != 0) {
+            subtree = record.childSmaller;
+        } else if (record.flags & FROZEN_VALUE) {
+            result = frozenIterator(radix, &record);
+            subtree = 0;
+        }
+    }
+
+    if (subtree == 0)
+        return result;
+
+    // Last value of the subtree is its greatest leaf
+    FrozenRecord record = frozenRecord(radix, subtree);
+
+    while (record.childSmaller != 0 || record.childGreater != 0) {
+        record = frozenRecord(radix, record.childGreater != 0 ? record.childGreater : record.childSmaller);
+    }
+
+    // Only the root of the empty structure is a leaf without a value
+    return (record.flags & FROZEN_VALUE) ? frozenIterator(radix, &record) : result;
+}
+
+// Returns the previous value in the inverse order (a record, then its greater and smaller subtrees) - the first
+// child or the smaller child of the deepest ancestor where the path goes to the greater one (the root for the empty iterator)
+static RadixIterator frozenPrevInverse(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    RadixIterator result = { .radix = radix };
+
+    size_t next = sizeof(Meta);
+
+    if (iterator->node != 0) {
+        FrozenRecord record = frozenRecord(radix, iterator->node);
+
+        next = record.childGreater != 0 ? record.childGreater : record.childSmaller;
+
+        for (size_t address = next == 0 ? sizeof(Meta) : 0; address != 0 && address != iterator->node;) {
+            FrozenRecord ancestor = frozenRecord(radix, address);
+
+            address = frozenToward(&ancestor, iterator->node);
+
+            if (address == ancestor.childGreater && ancestor.childSmaller != 0)
+                next = ancestor.childSmaller;
+        }
+    }
+
+    // Record without a value is followed by its first child
+    while (next != 0) {
+        FrozenRecord record = frozenRecord(radix, next);
+
+        if (record.flags & FROZEN_VALUE)
+            return frozenIterator(radix, &record);
+
+        next = record.childGreater != 0 ? record.childGreater : record.childSmaller;
+    }
+
+    return result;
+}
+
+// Returns the next value in the inverse order (subtrees before their record) - the first value of the greater subtree
+// skipped by the path or the deepest ancestor with a value (the first value of all for the empty iterator)
+static RadixIterator frozenNextInverse(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    RadixIterator result = { .radix = radix };
+
+    size_t subtree = iterator->node != 0 ? 0 : sizeof(Meta);
+
+    for (size_t address = iterator->node != 0 ? sizeof(Meta) : 0; address != 0 && address != iterator->node;) {
+        FrozenRecord record = frozenRecord(radix, address);
+
+        address = frozenToward(&record, iterator->node);
+
+        if (address == record.childSmaller && record.childGreater != 0) {
+            subtree = record.childGreater;
+        } else if (record.flags & FROZEN_VALUE) {
+            result = frozenIterator(radix, &record);
+            subtree = 0;
+        }
+    }
+
+    if (subtree == 0)
+        return result;
+
+    // First value of the subtree is its smallest leaf
+    FrozenRecord record = frozenRecord(radix, subtree);
+
+    while (record.childSmaller != 0 || record.childGreater != 0) {
+        record = frozenRecord(radix, record.childSmaller != 0 ? record.childSmaller : record.childGreater);
+    }
+
+    // Only the root of the empty structure is a leaf without a value
+    return (record.flags & FROZEN_VALUE) ? frozenIterator(radix, &record) : result;
+}
+
+// Returns the size of the key - the edges on the path from the root
+static size_t frozenKeyBits(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    size_t keyBits = 0;
+
+    for (size_t address = iterator->node != 0 ? sizeof(Meta) : 0; address != 0;) {
+        FrozenRecord record = frozenRecord(radix, address);
+
+        keyBits += record.keyBits;
+
+        address = address != iterator->node ? frozenToward(&record, iterator->node) : 0;
+    }
+
+    return keyBits;
+}
+
+// Copies the key so it ends at keyBits (the prefix that does not fit is cut)
+static RadixError frozenKeyCopy(RadixIterator *iterator, unsigned char *outputKey, size_t keyBits)
+{
+    Radix *radix = iterator->radix;
+
+    size_t totalBits = frozenKeyBits(iterator);
+    size_t cutBits = totalBits > keyBits ? totalBits - keyBits : 0;
+
+    size_t keyPos = 0;
+
+    for (size_t address = iterator->node != 0 ? sizeof(Meta) : 0; address != 0;) {
+        FrozenRecord record = frozenRecord(radix, address);
+
+        size_t skipBits = cutBits > keyPos ? (cutBits - keyPos < record.keyBits ? cutBits - keyPos : record.keyBits) : 0;
+
+        bitCopy(record.key, skipBits, outputKey, keyPos + skipBits + keyBits - totalBits, record.keyBits - skipBits);
+
+        keyPos += record.keyBits;
+
+        address = address != iterator->node ? frozenToward(&record, iterator->node) : 0;
+    }
+
+    return cutBits != 0 ? RADIX_OUT_OF_MEMORY : RADIX_SUCCESS;
+}
+
+// Returns the size of the key shared by two values - the key of their deepest common record
+static size_t frozenSharedBits(Radix *radix, size_t a, size_t b)
+{
+    size_t sharedBits = 0;
+
+    for (size_t address = sizeof(Meta); true;) {
+        FrozenRecord record = frozenRecord(radix, address);
+
+        sharedBits += record.keyBits;
+
+        if (address == a || address == b || frozenToward(&record, a) != frozenToward(&record, b))
+            return sharedBits;
+
+        address = frozenToward(&record, a);
+    }
+}
+
+RadixMatch radixMatch(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    // Frozen structure is read from its records
+    if (meta->frozen)
+        return frozenMatch(iterator, key, keyBits, FROZEN_MATCH_EXACT);
+
+    uint64_t time = itemTime(radix);
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the head-node
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        node = (Node *) (radix->memory + sizeof(Meta));
+    }
+
+    uint64_t hash = iterator->node == 0 && (meta->index != 0 || meta->filter != 0) ? keyHash(key, keyBits) : 0;
+
+    // If the filter rejects the key, there is no match starting from the head-node
+    if (iterator->node == 0 && meta->filter != 0 && !filterContains(radix, hash))
+        return result;
+
+    // If keys are indexed, the exact match starting from the head-node is found by hash
+    if (iterator->node == 0 && meta->index != 0) {
+        Node *indexNode = indexFind(radix, key, keyBits, hash);
+
+        Item *item = indexNode && indexNode->item != 0 ? (Item *) (radix->memory + indexNode->item) : NULL;
+
+        // If matched node has item (not nullable) - update match
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)indexNode - radix->memory;
+            result.matchedBits = keyBits;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+        }
+
+        // If all keys are indexed, the missing key does not exist
+        if (indexNode || !meta->indexOverflow)
+            return result;
+    }
+
+    for (size_t keyPos = 0; true;) {
+        // If keyPos has reached the size ..end iteration
+        if (keyPos >= keyBits) {
+            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+            // If matched node has item (not nullable) - update match
+            if (itemVisible(radix, item, time)) {
+                result.node = (unsigned char *)node - radix->memory;
+                result.matchedBits = keyPos;
+                result.data = itemData(radix, item);
+                result.dataSize = itemSize(item);
+
+                cacheTouch(radix, item);
+            }
+
+            break;
+        }
+
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        // Iterate..
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..break
+        if (childAddress == 0)
+            break;
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t testKeySize = testKeyRear - testKeyFore;
+
+        // Compare key with testKey
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // if key is not fully correct ..break
+        if (matchedBits < testKeySize)
+            break;
+
+        // Set child as current node and move key position
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    return result;
+}
+
+RadixMatch radixMatchNullable(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenMatch(iterator, key, keyBits, FROZEN_MATCH_EXACT);
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the head-node
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        node = (Node *) (radix->memory + sizeof(Meta));
+    }
+
+    uint64_t hash = iterator->node == 0 && (meta->index != 0 || meta->filter != 0) ? keyHash(key, keyBits) : 0;
+
+    // If the filter rejects the key, there is no match starting from the head-node
+    if (iterator->node == 0 && meta->filter != 0 && !filterContains(radix, hash))
+        return result;
+
+    // If keys are indexed, the exact match starting from the head-node is found by hash
+    if (iterator->node == 0 && meta->index != 0) {
+        Node *indexNode = indexFind(radix, key, keyBits, hash);
+
+        Item *item = indexNode && indexNode->item != 0 ? (Item *) (radix->memory + indexNode->item) : NULL;
+
+        // If matched node has item (nullable) - update match
+        if (item) {
+            result.node = (unsigned char *)indexNode - radix->memory;
+            result.matchedBits = keyBits;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+        }
+
+        // If all keys are indexed, the missing key does not exist
+        if (indexNode || !meta->indexOverflow)
+            return result;
+    }
+
+    for (size_t keyPos = 0; true;) {
+        // If keyPos has reached the size ..end iteration
+        if (keyPos >= keyBits) {
+            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+            // If matched node has item (nullable) - update match
+            if (item) {
+                result.node = (unsigned char *)node - radix->memory;
+                result.matchedBits = keyPos;
+                result.data = itemData(radix, item);
+                result.dataSize = itemSize(item);
+
+                cacheTouch(radix, item);
+            }
+
+            break;
+        }
+
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        // Iterate..
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..break
+        if (childAddress == 0)
+            break;
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t testKeySize = testKeyRear - testKeyFore;
+
+        // Compare key with testKey
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // If key is not fully correct ..break
+        if (matchedBits < testKeySize)
+            break;
+
+        // Set child as current node and move key position
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    return result;
+}
+
+RadixMatch radixMatchFirst(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenMatch(iterator, key, keyBits, FROZEN_MATCH_FIRST);
+
+    uint64_t time = itemTime(radix);
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the head-node
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        node = (Node *) (radix->memory + sizeof(Meta));
+    }
+
+    for (size_t keyPos = 0; true;) {
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (not nullable) - update match and break
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.matchedBits = keyPos;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            break;
+        }
+
+        // If keyPos has reached the size of the given key - break
+        if (keyBits <= keyPos)
+            break;
+
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        // Iterate..
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..break
+        if (childAddress == 0)
+            break;
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t testKeySize = testKeyRear - testKeyFore;
+
+        // Compare key with testKey
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // If key is not fully correct ..break
+        if (matchedBits < testKeySize)
+            break;
+
+        // Set child as current node and move key position
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    return result;
+}
+
+RadixMatch radixMatchFirstNullable(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenMatch(iterator, key, keyBits, FROZEN_MATCH_FIRST);
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the head-node
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        node = (Node *) (radix->memory + sizeof(Meta));
+    }
+
+    for (size_t keyPos = 0; true;) {
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - update match and break
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.matchedBits = keyPos;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            break;
+        }
+
+        // If keyPos has reached the size of the given key - break
+        if (keyBits <= keyPos)
+            break;
+
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        // Iterate..
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..break
+        if (childAddress == 0)
+            break;
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t testKeySize = testKeyRear - testKeyFore;
+
+        // Compare key with testKey
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // If key is not fully correct ..break
+        if (matchedBits < testKeySize)
+            break;
+
+        // Set child as current node and move key position
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    return result;
+}
+
+RadixMatch radixMatchLongest(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenMatch(iterator, key, keyBits, FROZEN_MATCH_LONGEST);
+
+    uint64_t time = itemTime(radix);
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the head-node
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0) return result;
+
+        node = (Node *) (radix->memory + sizeof(Meta));
+    }
+
+    for (size_t keyPos = 0; true;) {
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (not nullable) - update match and continue
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.matchedBits = keyPos;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+        }
+
+        // If keyPos has reached the size of the given key - break
+        if (keyBits <= keyPos)
+            break;
+
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        // Iterate..
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..break
+        if (childAddress == 0)
+            break;
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t testKeySize = testKeyRear - testKeyFore;
+
+        // Compare key with testKey
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // If key is not fully correct ..break
+        if (matchedBits < testKeySize)
+            break;
+
+        // Set child as current node and move key position
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    return result;
+}
+
+RadixMatch radixMatchLongestNullable(RadixIterator* iterator, unsigned char *key, size_t keyBits)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenMatch(iterator, key, keyBits, FROZEN_MATCH_LONGEST);
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the head-node
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        node = (Node *) (radix->memory + sizeof(Meta));
+    }
+
+    for (size_t keyPos = 0; true;) {
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - update match and continue
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.matchedBits = keyPos;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+        }
+
+        // If keyPos has reached the size of the given key - break
+        if (keyBits <= keyPos)
+            break;
+
+        // Get direction of iteration
+        bool direction = bitGet(key, keyPos);
+
+        // Iterate..
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..break
+        if (childAddress == 0)
+            break;
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t testKeySize = testKeyRear - testKeyFore;
+
+        // Compare key with testKey
+        size_t matchedBits = bitCompare(key, keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // If key is not fully correct ..break
+        if (matchedBits < testKeySize)
+            break;
+
+        // Set child as current node and move key position
+        node = testNode;
+        keyPos += matchedBits;
+    }
+
+    return result;
+}
+
+RadixIterator radixMatchToIterator(RadixMatch *match)
+{
+    return (RadixIterator) {
+        .radix = match->radix,
+        .node = match->node,
+        .data = match->data,
+        .dataSize = match->dataSize,
+    };
+}
+
+bool radixMatchIsEmpty(RadixMatch *match)
+{
+    return match->node == 0;
+}
+
+RadixIterator radixPredecessor(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenPredecessor(iterator);
+
+    uint64_t time = itemTime(radix);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, return null
+    if (!node)
+        return result;
+
+    while (true) {
+        node = node->parent != 0 ? (Node *)(radix->memory + node->parent) : NULL;
+
+        if (!node)
+            return result;
+
+        Item *item = node->item != 0 ? (Item *)(radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item (not nullable) - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixPredecessorNullable(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenPredecessor(iterator);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, return null
+    if (!node)
+        return result;
+
+    // Move to predecessor
+    while (true) {
+        node = node->parent != 0 ? (Node *)(radix->memory + node->parent) : NULL;
+
+        if (!node)
+            return result;
+
+        Item *item = node->item != 0 ? (Item *)(radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixPrev(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenPrev(iterator);
+
+    uint64_t time = itemTime(radix);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the greatest leaf of all nodes
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        // Retrieve head-node
+        node = (Node *) (radix->memory + sizeof(Meta));
+
+        // Move to the greatest leaf-node of given node
+        while (liveChild(radix, node->childSmaller) != 0 || liveChild(radix, node->childGreater) != 0) {
+            node = (Node *) (radix->memory + (liveChild(radix, node->childGreater) != 0 ? node->childGreater : node->childSmaller));
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item (not nullable) - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to smaller (shorter < longer)
+    // Priority:
+    // 1: parent-child-child (leaf child)
+    // 2: parent-child
+    // 3: parent
+    //   no parent - return empty iterator
+    while (true) {
+        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+        // "no parent"
+        if (!parentNode)
+            return result;
+
+        if (liveChild(radix, parentNode->childSmaller) != 0 && parentNode->childSmaller != (unsigned char*)node - radix->memory) {
+            node = (Node *) (radix->memory + parentNode->childSmaller);
+
+            // Move to "parent-child-child" or "parent-child"
+            while (liveChild(radix, node->childSmaller) != 0 || liveChild(radix, node->childGreater) != 0) {
+                node = (Node *) (radix->memory + (liveChild(radix, node->childGreater) != 0 ? node->childGreater : node->childSmaller));
+            }
+        } else {
+            // Move to "parent"
+            node = parentNode;
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item not (nullable) - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixPrevNullable(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenPrev(iterator);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the greatest leaf of all nodes
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        // Retrieve head-node
+        node = (Node *) (radix->memory + sizeof(Meta));
 
         // Move to the greatest leaf-node of given node
         while (node->childSmaller != 0 || node->childGreater != 0) {
             node = (Node *) (radix->memory + (node->childGreater != 0 ? node->childGreater : node->childSmaller));
         }
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to smaller (shorter < longer)
+    // Priority:
+    // 1: parent-child-child (leaf child)
+    // 2: parent-child
+    // 3: parent
+    //   no parent - return empty iterator
+    while (true) {
+        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+        // "no parent"
+        if (!parentNode)
+            return result;
+
+        if (parentNode->childSmaller != 0 && parentNode->childSmaller != (unsigned char*)node - radix->memory) {
+            node = (Node *) (radix->memory + parentNode->childSmaller);
+
+            // Move to "parent-child-child" or "parent-child"
+            while (node->childSmaller != 0 || node->childGreater != 0) {
+                node = (Node *) (radix->memory + (node->childGreater != 0 ? node->childGreater : node->childSmaller));
+            }
+        } else {
+            // Move to "parent"
+            node = parentNode;
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixNext(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenNext(iterator);
+
+    uint64_t time = itemTime(radix);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the smallest first of all nodes
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        // Retrieve head-node - this is smallest first of all nodes
+        node = (Node *) (radix->memory + sizeof(Meta));
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item (not nullable) - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to greater (shorter < longer)
+    // Priority:
+    // 1. child
+    // 2. parent-child
+    // 3. parent-parent-child
+    //   no parent - return empty iterator
+    while (true) {
+        // Move to "child"
+        if (liveChild(radix, node->childSmaller) != 0 || liveChild(radix, node->childGreater) != 0) {
+            node = (Node *) (radix->memory + (liveChild(radix, node->childSmaller) != 0 ? node->childSmaller : node->childGreater));
+
+            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+            RADIX_COUNT_VISIT(item);
+
+            // If matched node has item (not nullable) - this is the object you are looking for
+            if (itemVisible(radix, item, time)) {
+                result.node = (unsigned char *)node - radix->memory;
+                result.data = itemData(radix, item);
+                result.dataSize = itemSize(item);
+
+                return result;
+            }
+
+            continue;
+        }
+
+        // Move to "parent-child" or "parent-parent-child"
+        while (true) {
+            Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+            // "no parent"
+            if (!parentNode)
+                return result;
+
+            if (liveChild(radix, parentNode->childGreater) != 0 && parentNode->childGreater != (unsigned char*)node - radix->memory) {
+                node = (Node *) (radix->memory + parentNode->childGreater);
+
+                break;
+            }
+
+            node = parentNode;
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item (not nullable) - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixNextNullable(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenNext(iterator);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the smallest first of all nodes
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        // Retrieve head-node - this is smallest first of all nodes
+        node = (Node *) (radix->memory + sizeof(Meta));
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to greater (shorter < longer)
+    // Priority:
+    // 1. child
+    // 2. parent-child
+    // 3. parent-parent-child
+    //   no parent - return empty iterator
+    while (true) {
+        // Move to "child"
+        if (node->childSmaller != 0 || node->childGreater != 0) {
+            node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
+
+            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+            // If matched node has item (nullable) - this is the object you are looking for
+            if (item) {
+                result.node = (unsigned char *)node - radix->memory;
+                result.data = itemData(radix, item);
+                result.dataSize = itemSize(item);
+
+                return result;
+            }
+
+            continue;
+        }
+
+        // Move to "parent-child" or "parent-parent-child"
+        while (true) {
+            Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+            // "no parent"
+            if (!parentNode)
+                return result;
+
+            if (parentNode->childGreater != 0 && parentNode->childGreater != (unsigned char*)node - radix->memory) {
+                node = (Node *) (radix->memory + parentNode->childGreater);
+
+                break;
+            }
+
+            node = parentNode;
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixPrevInverse(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenPrevInverse(iterator);
+
+    uint64_t time = itemTime(radix);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // if node is null - start iteration by finding the greatest first of all nodes
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        // Retrieve head-node - this is greatest first of all nodes
+        node = (Node *) (radix->memory + sizeof(Meta));
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item not nullable - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to smaller (longer < shorter)
+    // Priority:
+    // 1. child
+    // 2. parent-child
+    // 3. parent-parent-child
+    //   no parent - return empty iterator
+    while (true) {
+        // move to "child"
+        if (liveChild(radix, node->childGreater) != 0 || liveChild(radix, node->childSmaller) != 0) {
+            node = (Node *) (radix->memory + (liveChild(radix, node->childGreater) != 0 ? node->childGreater : node->childSmaller));
+
+            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+            RADIX_COUNT_VISIT(item);
+
+            // If matched node has item not nullable - this is the object you are looking for
+            if (itemVisible(radix, item, time)) {
+                result.node = (unsigned char *)node - radix->memory;
+                result.data = itemData(radix, item);
+                result.dataSize = itemSize(item);
+
+                return result;
+            }
+
+            continue;
+        }
+
+        // Move to "parent-child" or "parent-parent-child"
+        while (true) {
+            Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+            // "no parent"
+            if (!parentNode)
+                return result;
+
+            if (liveChild(radix, parentNode->childSmaller) != 0 && parentNode->childSmaller != (unsigned char*)node - radix->memory) {
+                node = (Node *) (radix->memory + parentNode->childSmaller);
+
+                break;
+            }
+
+            node = parentNode;
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item not nullable - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixPrevInverseNullable(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenPrevInverse(iterator);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // if node is null - start iteration by finding the greatest first of all nodes
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        // Retrieve head-node - this is greatest first of all nodes
+        node = (Node *) (radix->memory + sizeof(Meta));
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to smaller (longer < shorter)
+    // Priority:
+    // 1. child
+    // 2. parent-child
+    // 3. parent-parent-child
+    //   no parent - return empty iterator
+    while (true) {
+        // move to "child"
+        if (node->childGreater != 0 || node->childSmaller != 0) {
+            node = (Node *) (radix->memory + (node->childGreater != 0 ? node->childGreater : node->childSmaller));
+
+            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+            // If matched node has item nullable - this is the object you are looking for
+            if (item) {
+                result.node = (unsigned char *)node - radix->memory;
+                result.data = itemData(radix, item);
+                result.dataSize = itemSize(item);
+
+                return result;
+            }
+
+            continue;
+        }
+
+        // Move to "parent-child" or "parent-parent-child"
+        while (true) {
+            Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+            // "no parent"
+            if (!parentNode)
+                return result;
+
+            if (parentNode->childSmaller != 0 && parentNode->childSmaller != (unsigned char*)node - radix->memory) {
+                node = (Node *) (radix->memory + parentNode->childSmaller);
+
+                break;
+            }
+
+            node = parentNode;
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixNextInverse(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenNextInverse(iterator);
+
+    uint64_t time = itemTime(radix);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the smallest leaf of all nodes
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        // Retrieve head-node
+        node = (Node *) (radix->memory + sizeof(Meta));
+
+        // Move to the smallest leaf-node of given node
+        while (liveChild(radix, node->childGreater) != 0 || liveChild(radix, node->childSmaller) != 0) {
+            node = (Node *) (radix->memory + (liveChild(radix, node->childSmaller) != 0 ? node->childSmaller : node->childGreater));
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item not nullable - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to greater (longer < shorter)
+    // Priority:
+    // 1: parent-child-child (leaf child)
+    // 2: parent-child
+    // 3: parent
+    //   no parent - return empty iterator
+    while (true) {
+        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+        // "no parent"
+        if (!parentNode)
+            return result;
+
+        // Move
+        if (liveChild(radix, parentNode->childGreater) != 0 && parentNode->childGreater != (unsigned char*)node - radix->memory) {
+            node = (Node *) (radix->memory + parentNode->childGreater);
+
+            // Move to "parent-child-child" or "parent-child"
+            while (liveChild(radix, node->childGreater) != 0 || liveChild(radix, node->childSmaller) != 0) {
+                node = (Node *) (radix->memory + (liveChild(radix, node->childSmaller) != 0 ? node->childSmaller : node->childGreater));
+            }
+        } else {
+            // Move to "parent"
+            node = parentNode;
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If matched node has item (not nullable) - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixNextInverseNullable(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenNextInverse(iterator);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // If node is null, this means we should start with the smallest leaf of all nodes
+    if (!node) {
+        // If the structure has not been managed before, you can't start from head
+        if (meta->lastNode == 0)
+            return result;
+
+        // Retrieve head-node
+        node = (Node *) (radix->memory + sizeof(Meta));
+
+        // Move to the smallest leaf-node of given node
+        while (node->childGreater != 0 || node->childSmaller != 0) {
+            node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to greater (longer < shorter)
+    // Priority:
+    // 1: parent-child-child (leaf child)
+    // 2: parent-child
+    // 3: parent
+    //   no parent - return empty iterator
+    while (true) {
+        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+        // "no parent"
+        if (!parentNode)
+            return result;
+
+        // Move
+        if (parentNode->childGreater != 0 && parentNode->childGreater != (unsigned char*)node - radix->memory) {
+            node = (Node *) (radix->memory + parentNode->childGreater);
+
+            // Move to "parent-child-child" or "parent-child"
+            while (node->childGreater != 0 || node->childSmaller != 0) {
+                node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
+            }
+        } else {
+            // Move to "parent"
+            node = parentNode;
+        }
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If matched node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixEarlier(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    uint64_t time = itemTime(radix);
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    // Frozen structure has no chronology
+    if (meta->frozen)
+        return result;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // if node is null - start iteration by finding the latest node
+    if (!node) {
+        node = meta->lastNode != 0 ? (Node *) (radix->memory + meta->lastNode) : NULL;
+
+        if (!node)
+            return result;
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If node has item (not nullable) - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to earlier node than given
+    while (true) {
+        node = node->lastNode != 0 ? (Node *) (radix->memory + node->lastNode) : NULL;
+
+        if (!node)
+            return result;
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        RADIX_COUNT_VISIT(item);
+
+        // If node has item (not nullable) - this is the object you are looking for
+        if (itemVisible(radix, item, time)) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixIterator radixEarlierNullable(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    // Frozen structure has no chronology
+    if (meta->frozen)
+        return result;
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    // if node is null - start iteration by finding the latest node
+    if (!node) {
+        node = meta->lastNode != 0 ? (Node *) (radix->memory + meta->lastNode) : NULL;
+
+        if (!node)
+            return result;
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to earlier node than given
+    while (true) {
+        node = node->lastNode != 0 ? (Node *) (radix->memory + node->lastNode) : NULL;
+
+        // If node has no earlier node - return empty iterator
+        if (!node)
+            return result;
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        // If node has item (nullable) - this is the object you are looking for
+        if (item) {
+            result.node = (unsigned char *)node - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+}
+
+RadixValue radixIteratorToValue(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Frozen value is stored in its record
+    if (meta->frozen) {
+        if (iterator->node != 0) {
+            FrozenRecord record = frozenRecord(radix, iterator->node);
+
+            result.item = record.address;
+            result.data = record.data;
+            result.dataSize = record.dataSize;
+        }
+
+        return result;
+    }
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    if (!node)
+        return result;
+
+    Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+    if (!item)
+        return result;
+
+    result.item = (unsigned char*)item - radix->memory;
+    result.data = itemData(radix, item);
+    result.dataSize = itemSize(item);
+
+    return result;
+}
+
+RadixCheckpoint radixIteratorToCheckpoint(RadixIterator *iterator)
+{
+    return (RadixCheckpoint) { .state = iterator->node };
+}
+
+bool radixIteratorIsEmpty(RadixIterator *iterator)
+{
+    return iterator->node == 0;
+}
+
+RadixValue radixValuePrevious(RadixValue *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    uint64_t time = itemTime(radix);
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Frozen structure has no history
+    if (meta->frozen)
+        return result;
+
+    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+
+    while (item) {
+        item = item->previous != 0 ? (Item *) (radix->memory + item->previous) : NULL;
+
+        if (itemVisible(radix, item, time)) {
+            result.item = (unsigned char *)item - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    return result;
+}
+
+RadixValue radixValuePreviousNullable(RadixValue *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Frozen structure has no history
+    if (meta->frozen)
+        return result;
+
+    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+
+    while (item) {
+        item = item->previous != 0 ? (Item *) (radix->memory + item->previous) : NULL;
+
+        if (item) {
+            result.item = (unsigned char *)item - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    return result;
+}
+
+// Returns the earlier visible value at the time of the operation
+static RadixValue valueEarlier(RadixValue *iterator, uint64_t time)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Frozen structure has no history
+    if (meta->frozen)
+        return result;
+
+    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+
+    // if item is null - start iteration by finding the latest value
+    if (!item) {
+        item = meta->lastItem != 0 ? (Item *) (radix->memory + meta->lastItem) : NULL;
+
+        if (itemVisible(radix, item, time)) {
+            result.item = (unsigned char *)item - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to earlier item than given
+    while (item) {
+        item = item->lastItem != 0 ? (Item *) (radix->memory + item->lastItem) : NULL;
+
+        if (itemVisible(radix, item, time)) {
+            result.item = (unsigned char *)item - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    return result;
+}
+
+RadixValue radixValueEarlier(RadixValue *iterator)
+{
+    return valueEarlier(iterator, itemTime(iterator->radix));
+}
+
+RadixValue radixValueEarlierNullable(RadixValue *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Frozen structure has no history
+    if (meta->frozen)
+        return result;
+
+    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+
+    // if item is null - start iteration by finding the latest value
+    if (!item) {
+        item = meta->lastItem != 0 ? (Item *) (radix->memory + meta->lastItem) : NULL;
+
+        if (item) {
+            result.item = (unsigned char *)item - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    // Move to earlier item than given
+    while (item) {
+        item = item->lastItem != 0 ? (Item *) (radix->memory + item->lastItem) : NULL;
+
+        if (item) {
+            result.item = (unsigned char *)item - radix->memory;
+            result.data = itemData(radix, item);
+            result.dataSize = itemSize(item);
+
+            return result;
+        }
+    }
+
+    return result;
+}
+
+RadixValue radixValueLater(RadixValue *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    uint64_t time = itemTime(radix);
+
+    RadixValue result = radixValueLaterNullable(iterator);
+
+    while (result.item != 0 && !itemVisible(radix, (Item *) (radix->memory + result.item), time)) {
+        result = radixValueLaterNullable(&result);
+    }
+
+    return result;
+}
+
+RadixValue radixValueLaterNullable(RadixValue *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Later item is the one which stores the given item as the earlier one
+    // (empty iterator is before the earliest item, its earlier item is null)
+    Item *item = timeFind(radix, iterator->item + 1);
+
+    while (item && item->lastItem > iterator->item) {
+        item = (Item *) (radix->memory + item->lastItem);
+    }
+
+    if (item && (size_t)((unsigned char *)item - radix->memory) > iterator->item) {
+        result.item = (unsigned char *)item - radix->memory;
+        result.data = itemData(radix, item);
+        result.dataSize = itemSize(item);
+    }
+
+    return result;
+}
+
+RadixValue radixValueSeek(Radix *radix, RadixCheckpoint *checkpoint)
+{
+    uint64_t time = itemTime(radix);
+
+    RadixValue result = radixValueSeekNullable(radix, checkpoint);
+
+    if (result.item != 0 && !itemVisible(radix, (Item *) (radix->memory + result.item), time))
+        result = valueEarlier(&result, time);
+
+    return result;
+}
+
+RadixValue radixValueSeekNullable(Radix *radix, RadixCheckpoint *checkpoint)
+{
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Walk back from the first indexed item after the checkpoint
+    Item *item = timeFind(radix, checkpoint->state);
+
+    while (item && (size_t)((unsigned char *)item - radix->memory) >= checkpoint->state) {
+        item = item->lastItem != 0 ? (Item *) (radix->memory + item->lastItem) : NULL;
+    }
+
+    if (item) {
+        result.item = (unsigned char *)item - radix->memory;
+        result.data = itemData(radix, item);
+        result.dataSize = itemSize(item);
+    }
+
+    return result;
+}
+
+size_t radixValueVersion(RadixValue *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (!meta->versions || iterator->item == 0)
+        return 0;
+
+    return itemVersion((Item *) (radix->memory + iterator->item))->number;
+}
+
+RadixValue radixValueAtVersion(RadixValue *iterator, size_t version)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+
+    if (!meta->versions || !item || version == 0 || version > itemVersion(item)->number)
+        return result;
+
+    // Jump unless the jump skips the version (the first version ends the loop)
+    while (itemVersion(item)->number > version) {
+        Item *jump = (Item *) (radix->memory + itemVersion(item)->jump);
+
+        item = itemVersion(jump)->number >= version ? jump : (Item *) (radix->memory + item->previous);
+    }
+
+    result.item = (unsigned char *)item - radix->memory;
+    result.data = itemData(radix, item);
+    result.dataSize = itemSize(item);
+
+    return result;
+}
+
+RadixValue radixValueAsOf(RadixValue *iterator, RadixCheckpoint *checkpoint)
+{
+    RadixValue result = radixValueAsOfNullable(iterator, checkpoint);
+
+    // Key was removed at the checkpoint
+    if (result.dataSize == 0) {
+        result.item = 0;
+        result.data = NULL;
+    }
+
+    return result;
+}
+
+RadixValue radixValueAsOfNullable(RadixValue *iterator, RadixCheckpoint *checkpoint)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixValue result = {0};
+
+    result.radix = radix;
+
+    // Frozen value has no history, it is the value as of the checkpoints after it
+    if (meta->frozen) {
+        if (iterator->item < checkpoint->state) {
+            result.item = iterator->item;
+            result.data = iterator->data;
+            result.dataSize = iterator->dataSize;
+        }
+
+        return result;
+    }
+
+    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+
+    // Items of the key are newer than their previous items, so the latest item before the checkpoint
+    // is found by the same jumps as versions (jump unless it skips the checkpoint)
+    while (item && (size_t)((unsigned char *)item - radix->memory) >= checkpoint->state) {
+        size_t jump = meta->versions ? itemVersion(item)->jump : 0;
+
+        if (jump != 0 && jump != (size_t)((unsigned char *)item - radix->memory) && jump >= checkpoint->state) {
+            item = (Item *) (radix->memory + jump);
+            continue;
+        }
+
+        item = item->previous != 0 ? (Item *) (radix->memory + item->previous) : NULL;
+    }
+
+    if (item) {
+        result.item = (unsigned char *)item - radix->memory;
+        result.data = itemData(radix, item);
+        result.dataSize = itemSize(item);
+    }
+
+    return result;
+}
+
+RadixIterator radixValueToIterator(RadixValue *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixIterator result = {0};
+
+    result.radix = radix;
+
+    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+
+    if (!item)
+        return result;
+
+    // Frozen value is stored in its record
+    result.node = meta->frozen ? iterator->item : item->node;
+    result.data = iterator->data;
+    result.dataSize = iterator->dataSize;
+
+    return result;
+}
+
+RadixCheckpoint radixValueToCheckpoint(RadixValue *iterator)
+{
+    return (RadixCheckpoint) { .state = iterator->item };
+}
+
+bool radixValueIsEmpty(RadixValue *iterator)
+{
+    return iterator->item == 0;
+}
+
+RadixError radixValueRead(RadixValue *iterator, unsigned char *output, size_t outputSize)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+
+    if (!item)
+        return RADIX_INVALID_ARGUMENT;
+
+    // Frozen data is stored in the record as is (it is decompressed by the freeze)
+    if (meta->frozen) {
+        FrozenRecord record = frozenRecord(radix, iterator->item);
+
+        if (record.dataSize > outputSize)
+            return RADIX_OUT_OF_MEMORY;
+
+        byteCopy(output, record.data, record.dataSize);
+
+        return RADIX_SUCCESS;
+    }
+
+    if (itemSize(item) > outputSize)
+        return RADIX_OUT_OF_MEMORY;
+
+    if (itemKind(item) == ITEM_COMPRESSED) {
+        ItemCompressed *compressed = (ItemCompressed *) itemStorage(item);
+
+        if (!decompress((unsigned char *)compressed + sizeof(ItemCompressed), compressed->size, output, itemSize(item)))
+            return RADIX_INVALID_ARGUMENT;
+
+        return RADIX_SUCCESS;
+    }
+
+    byteCopy(output, itemData(radix, item), itemSize(item));
+
+    return RADIX_SUCCESS;
+}
+
+size_t radixKeyBits(RadixIterator *iterator)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenKeyBits(iterator);
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    size_t keyBits = 0;
+
+    while(node) {
+        keyBits += CHAR_BIT * (node->keyRear - node->keyFore) + node->keyRearOffset - node->keyForeOffset;
+
+        node = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    }
+
+    return keyBits;
+}
+
+RadixError radixKeyCopy(RadixIterator *iterator, unsigned char *outputKey, size_t keyBits)
+{
+    Radix *radix = iterator->radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenKeyCopy(iterator, outputKey, keyBits);
+
+    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+
+    while (node) {
+        size_t nodeKeyBits = CHAR_BIT * (node->keyRear - node->keyFore) + node->keyRearOffset - node->keyForeOffset;
+
+        // If its out of memory.. copy only suffix of nodeKey and return error
+        if (keyBits < nodeKeyBits) {
+            size_t nodeKeySuffixOffset = nodeKeyBits + node->keyForeOffset - keyBits;
+
+            bitCopy(radix->memory + node->keyFore, nodeKeySuffixOffset, outputKey, keyBits, keyBits);
+
+            return RADIX_OUT_OF_MEMORY;
+        }
+
+        keyBits -= nodeKeyBits;
+
+        bitCopy(radix->memory + node->keyFore, node->keyForeOffset, outputKey, keyBits, nodeKeyBits);
+
+        node = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    }
+
+    return RADIX_SUCCESS;
+}
+
+RadixCheckpoint radixCheckpoint(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    return (RadixCheckpoint) { .state = meta->structureEnd };
+}
+
+RadixCheckpoint radixTimeCheckpoint(Radix *radix, uint64_t time)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->time == 0)
+        return radixCheckpoint(radix);
+
+    TimeEntry *entries = (TimeEntry *) (radix->memory + meta->time);
+
+    // Find the first entry with greater time
+    size_t fore = 0;
+    size_t rear = meta->timeCount;
+
+    while (fore < rear) {
+        size_t middle = fore + (rear - fore) / 2;
+
+        if (entries[middle].time <= time)
+            fore = middle + 1;
+        else
+            rear = middle;
+    }
+
+    // State before the first entry is the state of the cleared structure
+    return (RadixCheckpoint) { .state = fore != 0 ? entries[fore - 1].state : meta->timeOrigin };
+}
+
+void radixCheckpointRestore(Radix *radix, RadixCheckpoint *checkpoint)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    // Frozen structure and cache mode have no history
+    if (meta->frozen || meta->cache != 0)
+        return;
+
+    // Restore expiry heap (entries of restored items are removed, the rest is heapified again)
+    uint64_t expiryTime = 0;
+
+    if (meta->expiry != 0) {
+        ExpiryEntry *entries = (ExpiryEntry *) (radix->memory + meta->expiry);
+
+        size_t count = 0;
+
+        for (size_t i = 0; i < meta->expiryCount; i++) {
+            if (entries[i].item < checkpoint->state)
+                entries[count++] = entries[i];
+        }
+
+        if (count != meta->expiryCount) {
+            meta->expiryCount = count;
+
+            for (size_t i = count / 2; i-- > 0;) {
+                expirySiftDown(entries, i, count);
+            }
+        }
+
+        expiryTime = clockTime(radix);
+    }
+
+    // Restore items
+    while (meta->lastItem >= checkpoint->state) {
+        Item *item = meta->lastItem != 0 ? (Item *) (radix->memory + meta->lastItem) : NULL;
+
+        if (!item)
+            break;
+
+        // Restore item meta
+        meta->lastItem = item->lastItem;
+
+        // Release referenced data
+        itemRelease(item);
+
+        // Restore data deduplication (items sharing the data are newer, so they are already restored)
+        if (meta->dedup != 0 && itemKind(item) == ITEM_INLINE && itemSize(item) > sizeof(ItemShared))
+            dedupRemove(radix, item);
+
+        // Truncate value log (items are restored from the latest, so the log ends at the oldest restored value)
+        if (itemKind(item) == ITEM_LOG && itemSize(item) > 0)
+            meta->valueLogEnd = ((ItemLog *) itemStorage(item))->offset;
+
+        // Restore index (the first item of the node is followed by the index key)
+        if (meta->index != 0 && item->previous == 0)
+            indexRemove(radix, (IndexKey *) (itemStorage(item) + itemStorageSize(item)));
+
+        // Restore item owner
+        Node *node = (Node *) (radix->memory + item->node); // all items ​​have an owner, so we don't need to check it
+
+        statsItemRemove(meta, item, item->previous != 0 ? (Item *) (radix->memory + item->previous) : NULL);
+
+        node->item = item->previous;
+
+        liveUpdate(radix, node);
+
+        // Expired item could be already popped from the expiry heap (only expired items are popped, duplicates are skipped by the expire step)
+        if (meta->expiry != 0 && item->previous != 0 && item->previous < checkpoint->state) {
+            Item *previous = (Item *) (radix->memory + item->previous);
+            uint64_t expires = itemExpiry(meta, previous)->expires;
+
+            if (itemSize(previous) > 0 && expires != 0 && expires <= expiryTime && !expiryPush(radix, expires, item->previous))
+                meta->expiryOverflow = true;
+        }
+    }
+
+    // Restore time index (entries are sorted by items)
+    if (meta->time != 0) {
+        TimeEntry *entries = (TimeEntry *) (radix->memory + meta->time);
+
+        while (meta->timeCount != 0 && entries[meta->timeCount - 1].item >= checkpoint->state) {
+            meta->timeCount--;
+        }
+    }
+
+    // Restore nodes
+    while (meta->lastNode >= checkpoint->state) {
+        Node *node = meta->lastNode != 0 ? (Node *) (radix->memory + meta->lastNode) : NULL;
+
+        if (!node)
+            break;
+
+        // Restore node meta
+        meta->lastNode = node->lastNode;
+        meta->nodeCount--;
+        meta->keyBytes -= nodeKeyMemory(radix, node);
+
+        // Restore key fragment table (nodes sharing the key bytes are newer, so they are already restored)
+        if (meta->fragment != 0 && node->keyRear >= (size_t)((unsigned char *)node - radix->memory) + sizeof(Node))
+            fragmentRemove(radix, node);
+
+        // Restore node child (node is splitting node)
+        size_t splittedNodeAddress = node->childSmaller != 0 ? node->childSmaller : node->childGreater;
+
+        Node *splittedNode = splittedNodeAddress != 0 ? (Node *) (radix->memory + splittedNodeAddress) : NULL;
+
+        if (splittedNode) {
+            splittedNode->parent = node->parent;
+            splittedNode->keyFore = node->keyFore;
+            splittedNode->keyForeOffset = node->keyForeOffset;
+        }
+
+        // Restore node parent (taking into account whether a node is a splitting node)
+        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+
+        if (parentNode) {
+            bool direction = bitGet(radix->memory + node->keyFore, node->keyForeOffset);
+
+            Offset *parentNodeChildReference = direction ? &(parentNode->childGreater) : &(parentNode->childSmaller);
+
+            *parentNodeChildReference = splittedNode ? (unsigned char *)splittedNode - radix->memory : 0;
+        }
+    }
+
+    // Restore meta structure
+    meta->structureEnd = checkpoint->state;
+}
+
+RadixError radixClear(Radix* radix)
+{
+    size_t neededMemory = sizeof(Meta);
+
+    if (neededMemory > radix->memorySize) return RADIX_OUT_OF_MEMORY;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    *meta = (Meta) {
+        .lastNode = 0,
+        .lastItem = 0,
+        .structureEnd = neededMemory,
+    };
+
+    return RADIX_SUCCESS;
+}
+
+RadixError radixClearOptions(Radix *radix, RadixOptions *options)
+{
+    // Round index slots up to the power of two (slots are selected by mask)
+    size_t indexSlots = 0;
+
+    if (options->indexSlots != 0) {
+        for (indexSlots = 1; indexSlots < options->indexSlots; indexSlots <<= 1);
+    }
+
+    // Round filter bits up to the whole blocks
+    size_t filterBlocks = (options->filterBits + CHAR_BIT * RADIX_FILTER_BLOCK_SIZE - 1) / (CHAR_BIT * RADIX_FILTER_BLOCK_SIZE);
+
+    // Round deduplication slots up to the power of two
+    size_t dedupSlots = 0;
+
+    if (options->dedupSlots != 0) {
+        for (dedupSlots = 1; dedupSlots < options->dedupSlots; dedupSlots <<= 1);
+    }
+
+    // Round key fragment slots up to the power of two
+    size_t fragmentSlots = 0;
+
+    if (options->fragmentSlots != 0) {
+        for (fragmentSlots = 1; fragmentSlots < options->fragmentSlots; fragmentSlots <<= 1);
+    }
+
+    // Cache mode reuses the memory of evicted keys, so it keeps neither history nor shared copies of keys and data
+    if (options->cacheMemory != 0 && (indexSlots != 0 || filterBlocks != 0 || options->valueThreshold != 0 || dedupSlots != 0 || options->compressThreshold != 0 || fragmentSlots != 0 || options->alignNodes || options->versions || options->expirySlots != 0 || options->timeSlots != 0))
+        return RADIX_INVALID_ARGUMENT;
+
+    // Aligned nodes count the cache lines from the memory start
+    if (options->alignNodes && (uintptr_t)radix->memory % RADIX_CACHE_LINE_SIZE != 0)
+        return RADIX_INVALID_ARGUMENT;
+
+    size_t neededMemory = sizeof(Meta) + sizeof(Node) + indexSlots * sizeof(IndexEntry) + filterBlocks * RADIX_FILTER_BLOCK_SIZE + dedupSlots * sizeof(IndexEntry) + fragmentSlots * sizeof(IndexEntry) + options->timeSlots * sizeof(TimeEntry) + options->expirySlots * sizeof(ExpiryEntry);
+
+    if (neededMemory > radix->memorySize) return RADIX_OUT_OF_MEMORY;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    // Compose memory (the head-node is written before the options data)
+    Node *head = (Node *) (radix->memory + sizeof(Meta));
+    IndexEntry *indexEntries = (IndexEntry *) ((unsigned char *)head + sizeof(Node));
+    unsigned char *filter = (unsigned char *)(indexEntries + indexSlots);
+    IndexEntry *dedupEntries = (IndexEntry *) (filter + filterBlocks * RADIX_FILTER_BLOCK_SIZE);
+    IndexEntry *fragmentEntries = dedupEntries + dedupSlots;
+    TimeEntry *timeEntries = (TimeEntry *) (fragmentEntries + fragmentSlots);
+    ExpiryEntry *expiryEntries = (ExpiryEntry *) (timeEntries + options->timeSlots);
+
+    // Write head node
+    *head = (Node) {0};
+
+    // Write index
+    for (size_t i = 0; i < indexSlots; i++) {
+        indexEntries[i] = (IndexEntry) {0};
+    }
+
+    // Write filter
+    for (size_t i = 0; i < filterBlocks * RADIX_FILTER_BLOCK_SIZE; i++) {
+        filter[i] = 0;
+    }
+
+    // Write deduplication table
+    for (size_t i = 0; i < dedupSlots; i++) {
+        dedupEntries[i] = (IndexEntry) {0};
+    }
+
+    // Write key fragment table
+    for (size_t i = 0; i < fragmentSlots; i++) {
+        fragmentEntries[i] = (IndexEntry) {0};
+    }
+
+    // Write meta information
+    *meta = (Meta) {
+        .lastNode = (unsigned char *)head - radix->memory,
+        .lastItem = 0,
+        .structureEnd = neededMemory,
+        .index = indexSlots != 0 ? (unsigned char *)indexEntries - radix->memory : 0,
+        .indexSlots = indexSlots,
+        .indexCount = 0,
+        .indexOverflow = false,
+        .filter = filterBlocks != 0 ? filter - radix->memory : 0,
+        .filterBlocks = filterBlocks,
+        .filterKeys = 0,
+        .valueThreshold = options->valueThreshold,
+        .valueLogEnd = 0,
+        .dedup = dedupSlots != 0 ? (unsigned char *)dedupEntries - radix->memory : 0,
+        .dedupSlots = dedupSlots,
+        .dedupCount = 0,
+        .compressThreshold = options->compressThreshold,
+        .fragment = fragmentSlots != 0 ? (unsigned char *)fragmentEntries - radix->memory : 0,
+        .fragmentSlots = fragmentSlots,
+        .fragmentCount = 0,
+        .alignNodes = options->alignNodes,
+        .versions = options->versions,
+        .expiry = options->expirySlots != 0 ? (unsigned char *)expiryEntries - radix->memory : 0,
+        .expirySlots = options->expirySlots,
+        .expiryCount = 0,
+        .expiryOverflow = false,
+        .cache = options->cacheMemory != 0 ? neededMemory : 0,
+        .cacheEnd = neededMemory + (options->cacheMemory < radix->memorySize - neededMemory ? options->cacheMemory : radix->memorySize - neededMemory),
+        .cacheHand = neededMemory,
+        .cacheEvictions = 0,
+        .time = options->timeSlots != 0 ? (unsigned char *)timeEntries - radix->memory : 0,
+        .timeSlots = options->timeSlots,
+        .timeCount = 0,
+        .timeStride = options->timeStride != 0 ? options->timeStride : 1,
+        .timeSkipped = 0,
+        .timeOrigin = neededMemory,
+        .nodeCount = 1,
+    };
+
+    radixSetClock(radix, options->clock, options->clockContext);
+
+    return RADIX_SUCCESS;
+}
+
+size_t radixMemoryUsage(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    return meta->structureEnd;
+}
+
+size_t radixValueLogUsage(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    return meta->valueLogEnd;
+}
+
+static size_t valueLogLive(Radix *radix, size_t horizon, bool drop)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    size_t liveSize = 0;
+
+    // Each node keeps values of its items newer than the horizon and the value visible at the horizon
+    for (size_t nodeAddress = meta->lastNode; nodeAddress != 0;) {
+        Node *node = (Node *) (radix->memory + nodeAddress);
+
+        bool shadowed = false;
+
+        for (size_t itemAddress = node->item; itemAddress != 0;) {
+            Item *item = (Item *) (radix->memory + itemAddress);
+
+            if (itemKind(item) == ITEM_LOG && itemSize(item) > 0) {
+                if (!shadowed)
+                    liveSize += itemSize(item);
+                else if (drop) {
+                    meta->valueBytes -= itemSize(item);
+
+                    item->size &= ~ITEM_SIZE_MASK; // dropped value becomes null data
+                }
+            }
+
+            if (itemAddress < horizon)
+                shadowed = true;
+
+            itemAddress = item->previous;
+        }
+
+        nodeAddress = node->lastNode;
+    }
+
+    return liveSize;
+}
+
+RadixError radixValueLogCollect(Radix *radix, RadixCheckpoint *horizon, unsigned char *valueLog, size_t valueLogSize)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    size_t liveSize = valueLogLive(radix, horizon->state, false);
+
+    if (liveSize > valueLogSize)
+        return RADIX_OUT_OF_MEMORY;
+
+    valueLogLive(radix, horizon->state, true);
+
+    // Copy live values (items are visited from the latest, so values keep their chronological order)
+    size_t valueLogEnd = liveSize;
+
+    for (size_t itemAddress = meta->lastItem; itemAddress != 0;) {
+        Item *item = (Item *) (radix->memory + itemAddress);
+
+        if (itemKind(item) == ITEM_LOG && itemSize(item) > 0) {
+            ItemLog *log = (ItemLog *) itemStorage(item);
+
+            valueLogEnd -= itemSize(item);
+
+            byteCopy(valueLog + valueLogEnd, radix->valueLog + log->offset, itemSize(item));
+
+            log->offset = valueLogEnd;
+        }
+
+        itemAddress = item->lastItem;
+    }
+
+    meta->valueLogEnd = liveSize;
+
+    radix->valueLog = valueLog;
+    radix->valueLogSize = valueLogSize;
+
+    return RADIX_SUCCESS;
+}
+
+// Returns false if the parts do not fit into the radix memory (every part needs its meta and head-node)
+static inline bool partRegion(Radix *radix, size_t partitionBits, size_t *regionFore, size_t *regionSize)
+{
+    // Regions are placed after the memory needed for meta and head-node of the stitched structure
+    size_t fore = sizeof(Meta) + sizeof(Node);
+
+    fore = (fore + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+
+    *regionFore = fore;
+    *regionSize = 0;
+
+    // Number of parts has to be representable
+    if (partitionBits >= sizeof(size_t) * CHAR_BIT)
+        return false;
+
+    size_t partCount = (size_t)1 << partitionBits;
+
+    size_t size = radix->memorySize > fore ? (radix->memorySize - fore) / partCount : 0;
+
+    *regionSize = size / sizeof(size_t) * sizeof(size_t);
+
+    return *regionSize >= sizeof(Meta) + sizeof(Node);
+}
+
+static inline size_t relocate(size_t address, size_t base)
+{
+    return address != 0 ? address + base : 0;
+}
+
+size_t radixPartition(unsigned char *key, size_t keyBits, size_t partitionBits)
+{
+    size_t part = 0;
+
+    // Number of parts is not representable
+    if (partitionBits >= sizeof(size_t) * CHAR_BIT)
+        return SIZE_MAX;
+
+    // Keys shorter than partition do not belong to any part
+    if (keyBits < partitionBits)
+        return (size_t)1 << partitionBits;
+
+    for (size_t i = 0; i < partitionBits; i++) {
+        part = (part << 1) | bitGet(key, i);
+    }
+
+    return part;
+}
+
+Radix radixPartCreate(Radix *radix, size_t part, size_t partitionBits)
+{
+    size_t regionFore;
+    size_t regionSize;
+
+    if (!partRegion(radix, partitionBits, &regionFore, &regionSize) || part >= (size_t)1 << partitionBits)
+        return radixCreate(NULL, 0);
+
+    Radix result = radixCreate(radix->memory + regionFore + part * regionSize, regionSize);
+
+    radixSetClock(&result, radix->clock, radix->clockContext);
+
+    return result;
+}
+
+RadixError radixPartsStitch(Radix *radix, Radix *parts, size_t partitionBits)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    size_t regionFore;
+    size_t regionSize;
+
+    if (!partRegion(radix, partitionBits, &regionFore, &regionSize))
+        return RADIX_INVALID_ARGUMENT;
+
+    size_t partCount = (size_t)1 << partitionBits;
+
+    // Items of all parts are versioned or none of them
+    int versions = -1;
+
+    // Split nodes of grafts are written after the last part (one per grafted child at most)
+    size_t graftMemory = 0;
+    size_t lastPartEnd = 0;
+
+    // Validate parts - every edge leaving a part head-node must start with the part prefix,
+    // this guarantees that grafted nodes never collide with each other
+    for (size_t part = 0; part < partCount; part++) {
+        Meta *partMeta = (Meta *)parts[part].memory;
+
+        if (parts[part].memory != radix->memory + regionFore + part * regionSize)
+            return RADIX_INVALID_ARGUMENT;
+
+        // Frozen part has no head-node, it would be stitched as an empty one
+        if (partMeta->frozen)
+            return RADIX_INVALID_ARGUMENT;
+
+        if (partMeta->lastNode == 0)
+            continue;
+
+        if (versions != -1 && versions != partMeta->versions)
+            return RADIX_INVALID_ARGUMENT;
+
+        // Expiry heaps and cache blocks of parts are not merged, the stitched structure has only one value log
+        if (partMeta->expiry != 0 || partMeta->cache != 0 || partMeta->valueThreshold != 0 || partMeta->valueLogEnd != 0)
+            return RADIX_INVALID_ARGUMENT;
+
+        versions = partMeta->versions;
+
+        Node *partHead = (Node *) (parts[part].memory + sizeof(Meta));
+
+        if (partHead->item != 0 && partitionBits != 0)
+            return RADIX_INVALID_ARGUMENT;
+
+        size_t partChildren[] = { partHead->childSmaller, partHead->childGreater };
+
+        for (size_t i = 0; i < 2; i++) {
+            Node *child = partChildren[i] != 0 ? (Node *) (parts[part].memory + partChildren[i]) : NULL;
+
+            if (!child)
+                continue;
+
+            size_t childKeyBits = CHAR_BIT * (child->keyRear - child->keyFore) + child->keyRearOffset - child->keyForeOffset;
+
+            if (childKeyBits < partitionBits)
+                return RADIX_INVALID_ARGUMENT;
+
+            size_t childPart = 0;
+
+            for (size_t j = 0; j < partitionBits; j++) {
+                childPart = (childPart << 1) | bitGet(parts[part].memory + child->keyFore, child->keyForeOffset + j);
+            }
+
+            if (childPart != part)
+                return RADIX_INVALID_ARGUMENT;
+
+            graftMemory += sizeof(Node);
+        }
+
+        lastPartEnd = partMeta->structureEnd;
+    }
+
+    // Split nodes must not reach the regions of the following (empty) parts
+    if (graftMemory > regionSize - lastPartEnd)
+        return RADIX_OUT_OF_MEMORY;
+
+    // Write head node
+    Node *head = (Node *) (radix->memory + sizeof(Meta));
+
+    *head = (Node) {0};
+
+    // Write meta information
+    *meta = (Meta) {
+        .lastNode = (unsigned char *)head - radix->memory,
+        .lastItem = 0,
+        .structureEnd = regionFore,
+        .versions = versions == 1,
+        .nodeCount = 1,
+    };
+
+    // Relocate parts and join them to the chronological order of the stitched structure
+    for (size_t part = 0; part < partCount; part++) {
+        Meta *partMeta = (Meta *)parts[part].memory;
+
+        if (partMeta->lastNode == 0)
+            continue;
+
+        size_t base = parts[part].memory - radix->memory;
+        size_t partHeadAddress = base + sizeof(Meta);
+
+        size_t partLastNode = relocate(partMeta->lastNode, base);
+        size_t partLastItem = relocate(partMeta->lastItem, base);
+
+        // Relocate nodes (part head-node is not a part of the chronological order)
+        for (size_t nodeAddress = partLastNode; nodeAddress != partHeadAddress;) {
+            Node *node = (Node *) (radix->memory + nodeAddress);
+
+            node->parent = relocate(node->parent, base);
+            node->childSmaller = relocate(node->childSmaller, base);
+            node->childGreater = relocate(node->childGreater, base);
+            node->keyFore = relocate(node->keyFore, base);
+            node->keyRear = relocate(node->keyRear, base);
+            node->item = relocate(node->item, base);
+            node->lastNode = relocate(node->lastNode, base);
+
+            nodeAddress = node->lastNode;
+
+            if (node->lastNode == partHeadAddress)
+                node->lastNode = meta->lastNode;
+        }
+
+        // Relocate part head-node
+        Node *partHead = (Node *) (radix->memory + partHeadAddress);
+
+        partHead->childSmaller = relocate(partHead->childSmaller, base);
+        partHead->childGreater = relocate(partHead->childGreater, base);
+        partHead->item = relocate(partHead->item, base);
+
+        // Relocate items
+        for (size_t itemAddress = partLastItem; itemAddress != 0;) {
+            Item *item = (Item *) (radix->memory + itemAddress);
+
+            item->node = relocate(item->node, base);
+            item->previous = relocate(item->previous, base);
+            item->lastItem = relocate(item->lastItem, base);
+
+            if (partMeta->versions)
+                itemVersion(item)->jump = relocate(itemVersion(item)->jump, base);
+
+            // Deduplicated data is shared with an item of the same part
+            if (itemKind(item) == ITEM_SHARED) {
+                ItemShared *shared = (ItemShared *) itemStorage(item);
+
+                shared->item = relocate(shared->item, base);
+            }
+
+            itemAddress = item->lastItem;
+
+            if (item->lastItem == 0)
+                item->lastItem = meta->lastItem;
+        }
+
+        // Update meta information
+        if (partLastNode != partHeadAddress)
+            meta->lastNode = partLastNode;
+
+        if (partLastItem != 0)
+            meta->lastItem = partLastItem;
+
+        meta->structureEnd = base + partMeta->structureEnd;
+
+        // Merge statistics (part head-node is replaced by the head-node)
+        meta->nodeCount += partMeta->nodeCount - 1;
+        meta->itemCount += partMeta->itemCount;
+        meta->liveCount += partMeta->liveCount;
+        meta->nullCount += partMeta->nullCount;
+        meta->keyBytes += partMeta->keyBytes;
+        meta->valueBytes += partMeta->valueBytes;
+        meta->deadBytes += partMeta->deadBytes;
+    }
+
+    // Graft parts - split nodes are written after the last part
+    for (size_t part = 0; part < partCount; part++) {
+        Meta *partMeta = (Meta *)parts[part].memory;
+
+        if (partMeta->lastNode == 0)
+            continue;
+
+        Node *partHead = (Node *) (parts[part].memory + sizeof(Meta));
+
+        // Move items of the empty key (possible only with a single part)
+        if (partHead->item != 0) {
+            for (size_t itemAddress = partHead->item; itemAddress != 0;) {
+                Item *item = (Item *) (radix->memory + itemAddress);
+
+                item->node = (unsigned char *)head - radix->memory;
+
+                itemAddress = item->previous;
+            }
+
+            head->item = partHead->item;
+
+            liveUpdate(radix, head);
+        }
+
+        // Graft children of the part head-node
+        size_t partChildren[] = { partHead->childSmaller, partHead->childGreater };
+
+        for (size_t i = 0; i < 2; i++) {
+            Node *graftNode = partChildren[i] != 0 ? (Node *) (radix->memory + partChildren[i]) : NULL;
+
+            if (!graftNode)
+                continue;
+
+            unsigned char *graftKey = radix->memory + graftNode->keyFore;
+
+            size_t graftKeyFore = graftNode->keyForeOffset;
+            size_t graftKeyRear = CHAR_BIT * (graftNode->keyRear - graftNode->keyFore) + graftNode->keyRearOffset;
+
+            Node *node = head;
+
+            for (size_t keyPos = graftKeyFore; true;) {
+                // Get direction of iteration
+                bool direction = bitGet(graftKey, keyPos);
+
+                // Iterate..
+                size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+                // If there is no child ..attach the grafted node and end iteration
+                if (childAddress == 0) {
+                    graftNode->parent = (unsigned char *)node - radix->memory;
+                    graftNode->keyFore += keyPos / CHAR_BIT;
+                    graftNode->keyForeOffset = keyPos % CHAR_BIT;
+
+                    Offset *nodeChild = direction ? &(node->childGreater) : &(node->childSmaller);
+
+                    *nodeChild = (unsigned char *)graftNode - radix->memory;
+
+                    liveUpdate(radix, node);
+
+                    break;
+                }
+
+                // Check if the key is correct
+                Node *testNode = (Node *) (radix->memory + childAddress);
+
+                unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+                size_t testKeyFore = testNode->keyForeOffset;
+                size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+                size_t testKeyBits = testKeyRear - testKeyFore;
+
+                // Compare key with testKey
+                size_t matchedBits = bitCompare(graftKey, keyPos, graftKeyRear, testKey, testKeyFore, testKeyRear);
+
+                // If key is not fully maching ..split this node and continue iteration
+                if (matchedBits < testKeyBits) {
+                    // Calculate needed memory
+                    size_t neededMemory = sizeof(Node);
+
+                    // Check free memory
+                    if (neededMemory > radix->memorySize - meta->structureEnd)
+                        return RADIX_OUT_OF_MEMORY;
+
+                    // Compose memory
+                    Node *newNode = (Node *) (radix->memory + meta->structureEnd);
+
+                    // Get split direction
+                    bool splitDirection = bitGet(testKey, testKeyFore + matchedBits);
+
+                    // Write split node
+                    *newNode = (Node) {
+                        .parent = testNode->parent,
+                        .childSmaller = splitDirection ? 0 : (unsigned char *)testNode - radix->memory,
+                        .childGreater = splitDirection ? (unsigned char *)testNode - radix->memory : 0,
+                        .keyFore = testNode->keyFore,
+                        .keyRear = testNode->keyFore + ((testNode->keyForeOffset + matchedBits) / CHAR_BIT),
+                        .keyForeOffset = testNode->keyForeOffset,
+                        .keyRearOffset = (testNode->keyForeOffset + matchedBits) % CHAR_BIT,
+                        .live = testNode->live,
+                        .lastNode = meta->lastNode,
+                        .item = 0,
+                    };
+
+                    // Update splited node
+                    testNode->parent = (unsigned char *)newNode - radix->memory;
+                    testNode->keyFore = newNode->keyRear;
+                    testNode->keyForeOffset = newNode->keyRearOffset;
+
+                    // Set new node as node child
+                    Offset *nodeChild = direction ? &(node->childGreater) : &(node->childSmaller);
+
+                    *nodeChild = (unsigned char *)newNode - radix->memory;
+
+                    // Update meta information
+                    meta->lastNode = (unsigned char *)newNode - radix->memory;
+                    meta->structureEnd += neededMemory;
+                    meta->nodeCount++;
+
+                    // Assign new node as fully maching node
+                    testNode = newNode;
+                }
+
+                // key is fully correct, set testNode as node
+                node = testNode;
+                keyPos += matchedBits;
+            }
+        }
+    }
+
+    return RADIX_SUCCESS;
+}
+
+RadixShards radixShardsCreate(Radix *shards, size_t shardBits)
+{
+    return (RadixShards){
+        .shards = shards,
+        .shardBits = shardBits,
+    };
+}
+
+size_t radixShardsIndex(RadixShards *shards, unsigned char *key, size_t keyBits)
+{
+    size_t shard = 0;
+
+    // Keys shorter than shardBits are completed with zero bits, so they are
+    // owned by the shard with their smallest extension (shorter < longer)
+    for (size_t i = 0; i < shards->shardBits; i++) {
+        shard = (shard << 1) | (i < keyBits ? bitGet(key, i) : false);
+    }
+
+    return shard;
+}
+
+RadixValue radixShardsInsert(RadixShards *shards, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize)
+{
+    RadixIterator iterator = radixIterator(&shards->shards[radixShardsIndex(shards, key, keyBits)]);
+
+    return radixInsert(&iterator, key, keyBits, data, dataSize);
+}
+
+RadixValue radixShardsRemove(RadixShards *shards, unsigned char *key, size_t keyBits)
+{
+    RadixIterator iterator = radixIterator(&shards->shards[radixShardsIndex(shards, key, keyBits)]);
+
+    return radixRemove(&iterator, key, keyBits);
+}
+
+RadixMatch radixShardsMatch(RadixShards *shards, unsigned char *key, size_t keyBits)
+{
+    RadixIterator iterator = radixIterator(&shards->shards[radixShardsIndex(shards, key, keyBits)]);
+
+    return radixMatch(&iterator, key, keyBits);
+}
+
+RadixMatch radixShardsMatchNullable(RadixShards *shards, unsigned char *key, size_t keyBits)
+{
+    RadixIterator iterator = radixIterator(&shards->shards[radixShardsIndex(shards, key, keyBits)]);
+
+    return radixMatchNullable(&iterator, key, keyBits);
+}
+
+RadixIterator radixShardsPrev(RadixShards *shards, RadixIterator *iterator)
+{
+    size_t shardCount = (size_t)1 << shards->shardBits;
+
+    // If iterator is empty, this means we should start with the last shard
+    size_t shard = shardCount;
+
+    if (!radixIteratorIsEmpty(iterator)) {
+        RadixIterator result = radixPrev(iterator);
+
+        if (!radixIteratorIsEmpty(&result))
+            return result;
+
+        shard = iterator->radix - shards->shards;
+    }
+
+    // Move to the largest element of the previous non-empty shard
+    while (shard > 0) {
+        shard--;
+
+        RadixIterator shardIterator = radixIterator(&shards->shards[shard]);
+
+        RadixIterator result = radixPrev(&shardIterator);
+
+        if (!radixIteratorIsEmpty(&result))
+            return result;
+    }
+
+    return radixIterator(&shards->shards[0]);
+}
+
+RadixIterator radixShardsNext(RadixShards *shards, RadixIterator *iterator)
+{
+    size_t shardCount = (size_t)1 << shards->shardBits;
+
+    // If iterator is empty, this means we should start with the first shard
+    size_t shard = 0;
+
+    if (!radixIteratorIsEmpty(iterator)) {
+        RadixIterator result = radixNext(iterator);
+
+        if (!radixIteratorIsEmpty(&result))
+            return result;
+
+        shard = iterator->radix - shards->shards + 1;
+    }
+
+    // Move to the smallest element of the next non-empty shard
+    for (; shard < shardCount; shard++) {
+        RadixIterator shardIterator = radixIterator(&shards->shards[shard]);
+
+        RadixIterator result = radixNext(&shardIterator);
+
+        if (!radixIteratorIsEmpty(&result))
+            return result;
+    }
+
+    return radixIterator(&shards->shards[0]);
+}
+
+static inline Node *fingerAncestorShared(Radix *radix, RadixFinger *finger, size_t sharedBits, size_t *nodeKeyBits)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    Node *node = finger->iterator.node != 0 ? (Node *) (radix->memory + finger->iterator.node) : NULL;
+
+    // If finger is empty (or its node may be evicted by the cache mode), this means we should start with the head-node
+    if (!node || meta->cache != 0) {
+        *nodeKeyBits = 0;
+
+        return (Node *) (radix->memory + sizeof(Meta));
+    }
+
+    *nodeKeyBits = finger->keyBits;
+
+    // Move up until the node key is a prefix of the shared bits
+    while (*nodeKeyBits > sharedBits) {
+        *nodeKeyBits -= CHAR_BIT * (node->keyRear - node->keyFore) + node->keyRearOffset - node->keyForeOffset;
+
+        node = (Node *) (radix->memory + node->parent); // only the head-node has no parent and its key is empty
+    }
+
+    return node;
+}
+
+static inline Node *fingerAncestor(Radix *radix, RadixFinger *finger, unsigned char *key, size_t keyBits, size_t *nodeKeyBits)
+{
+    // Bits shared by the key and the finger key
+    size_t sharedBits = finger->iterator.node != 0 ? bitCompare(finger->key, 0, finger->keyBits, key, 0, keyBits) : 0;
+
+    return fingerAncestorShared(radix, finger, sharedBits, nodeKeyBits);
+}
+
+static inline void fingerMove(RadixFinger *finger, size_t node, unsigned char *key, size_t keyBits)
+{
+    size_t keySize = (keyBits + CHAR_BIT - 1) / CHAR_BIT;
+
+    // If key can not be remembered ..start next operation from the head-node
+    if (node == 0 || keySize > finger->keyMemorySize) {
+        finger->iterator.node = 0;
+        finger->keyBits = 0;
+
+        return;
+    }
+
+    byteCopy(finger->key, key, keySize);
+
+    finger->iterator.node = node;
+    finger->keyBits = keyBits;
+}
+
+static inline Node *fingerDescend(Radix *radix, Node *node, unsigned char *key, size_t *keyPos, size_t keyBits)
+{
+    while (*keyPos < keyBits) {
+        // Get direction of iteration
+        bool direction = bitGet(key, *keyPos);
+
+        // Iterate..
+        size_t childAddress = direction ? node->childGreater : node->childSmaller;
+
+        // If there is no child ..break
+        if (childAddress == 0)
+            break;
+
+        // Check if the key is correct
+        Node *testNode = (Node *) (radix->memory + childAddress);
+
+        unsigned char *testKey = (unsigned char *) (radix->memory + testNode->keyFore);
+
+        size_t testKeyFore = testNode->keyForeOffset;
+        size_t testKeyRear = CHAR_BIT * (testNode->keyRear - testNode->keyFore) + testNode->keyRearOffset;
+
+        size_t testKeySize = testKeyRear - testKeyFore;
+
+        // Compare key with testKey
+        size_t matchedBits = bitCompare(key, *keyPos, keyBits, testKey, testKeyFore, testKeyRear);
+
+        // If key is not fully correct ..break
+        if (matchedBits < testKeySize)
+            break;
+
+        // Set child as current node and move key position
+        node = testNode;
+        *keyPos += matchedBits;
+    }
+
+    return node;
+}
+
+RadixFinger radixFinger(Radix *radix, unsigned char *keyMemory, size_t keyMemorySize)
+{
+    return (RadixFinger){
+        .iterator = radixIterator(radix),
+        .key = keyMemory,
+        .keyBits = 0,
+        .keyMemorySize = keyMemorySize,
+    };
+}
+
+RadixValue radixFingerInsert(RadixFinger *finger, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize)
+{
+    Radix *radix = finger->iterator.radix;
+
+    RadixValue result;
+
+    // If finger is empty, insert from the head-node (it may need to be initialized)
+    if (radixIteratorIsEmpty(&finger->iterator)) {
+        result = radixInsert(&finger->iterator, key, keyBits, data, dataSize);
+    } else {
+        size_t nodeKeyBits;
+
+        Node *node = fingerAncestor(radix, finger, key, keyBits, &nodeKeyBits);
+
+        result = insert(radix, node, key, nodeKeyBits, keyBits, ITEM_INLINE, data, dataSize, dataSize, 0);
+    }
+
+    Item *item = result.item != 0 ? (Item *) (radix->memory + result.item) : NULL;
+
+    fingerMove(finger, item ? item->node : 0, key, keyBits);
+
+    return result;
+}
+
+RadixValue radixFingerRemove(RadixFinger *finger, unsigned char *key, size_t keyBits)
+{
+    return radixFingerInsert(finger, key, keyBits, NULL, 0);
+}
+
+RadixMatch radixFingerMatch(RadixFinger *finger, unsigned char *key, size_t keyBits)
+{
+    Radix *radix = finger->iterator.radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    // Frozen structure has no parents to resume from, keys are matched from the root
+    if (meta->frozen) {
+        RadixIterator root = radixIterator(radix);
+
+        return frozenMatch(&root, key, keyBits, FROZEN_MATCH_EXACT);
+    }
+
+    uint64_t time = itemTime(radix);
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    // If the structure has not been managed before, you can't start from head
+    if (meta->lastNode == 0)
+        return result;
+
+    size_t keyPos;
+
+    Node *node = fingerAncestor(radix, finger, key, keyBits, &keyPos);
+
+    node = fingerDescend(radix, node, key, &keyPos, keyBits);
+
+    fingerMove(finger, (unsigned char *)node - radix->memory, key, keyPos);
+
+    // If keyPos has not reached the size ..there is no match
+    if (keyPos < keyBits)
+        return result;
+
+    Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+    // If matched node has item (not nullable) - update match
+    if (itemVisible(radix, item, time)) {
+        result.node = (unsigned char *)node - radix->memory;
+        result.matchedBits = keyPos;
+        result.data = itemData(radix, item);
+        result.dataSize = itemSize(item);
+
+        cacheTouch(radix, item);
+    }
+
+    return result;
+}
+
+RadixMatch radixFingerMatchNullable(RadixFinger *finger, unsigned char *key, size_t keyBits)
+{
+    Radix *radix = finger->iterator.radix;
+
+    Meta *meta = (Meta *)radix->memory;
+
+    // Frozen structure has no parents to resume from, keys are matched from the root
+    if (meta->frozen) {
+        RadixIterator root = radixIterator(radix);
+
+        return frozenMatch(&root, key, keyBits, FROZEN_MATCH_EXACT);
+    }
+
+    RadixMatch result = {0};
+
+    result.radix = radix;
+
+    // If the structure has not been managed before, you can't start from head
+    if (meta->lastNode == 0)
+        return result;
+
+    size_t keyPos;
+
+    Node *node = fingerAncestor(radix, finger, key, keyBits, &keyPos);
+
+    node = fingerDescend(radix, node, key, &keyPos, keyBits);
+
+    fingerMove(finger, (unsigned char *)node - radix->memory, key, keyPos);
+
+    // If keyPos has not reached the size ..there is no match
+    if (keyPos < keyBits)
+        return result;
+
+    Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+    // If matched node has item (nullable) - update match
+    if (item) {
+        result.node = (unsigned char *)node - radix->memory;
+        result.matchedBits = keyPos;
+        result.data = itemData(radix, item);
+        result.dataSize = itemSize(item);
+
+        cacheTouch(radix, item);
+    }
+
+    return result;
+}
+
+static inline bool batchEntryLess(RadixBatchEntry *a, RadixBatchEntry *b)
+{
+    size_t matchedBits = bitCompare(a->key, 0, a->keyBits, b->key, 0, b->keyBits);
+
+    // Keys differ on a bit - smaller bit goes first
+    if (matchedBits < a->keyBits && matchedBits < b->keyBits)
+        return !bitGet(a->key, matchedBits);
+
+    // One key is a prefix of another - shorter goes first (shorter < longer)
+    if (a->keyBits != b->keyBits)
+        return a->keyBits < b->keyBits;
+
+    // The same keys keep the order of pushing
+    return a->sequence < b->sequence;
+}
+
+// Public header does not depend on C11 atomics ..the tail and turns are plain words accessed atomically here
+typedef char BatchAtomicSize[sizeof(atomic_size_t) == sizeof(size_t) && _Alignof(atomic_size_t) == _Alignof(size_t) ? 1 : -1];
+
+static inline atomic_size_t *batchTail(RadixBatch *batch)
+{
+    return (atomic_size_t *)&batch->tail;
+}
+
+static inline atomic_size_t *batchTurn(RadixBatchEntry *entry)
+{
+    return (atomic_size_t *)&entry->turn;
+}
+
+// Entries of the ring are addressed from its head, the turn of the entry stays in its slot
+static inline RadixBatchEntry *batchEntry(RadixBatch *batch, size_t index)
+{
+    return &batch->entries[(batch->head + index) % batch->capacity];
+}
+
+static inline void batchEntrySwap(RadixBatchEntry *a, RadixBatchEntry *b)
+{
+    RadixBatchEntry entry;
+
+    entry.key = a->key;
+    entry.keyBits = a->keyBits;
+    entry.data = a->data;
+    entry.dataSize = a->dataSize;
+    entry.callback = a->callback;
+    entry.context = a->context;
+    entry.sequence = a->sequence;
+
+    a->key = b->key;
+    a->keyBits = b->keyBits;
+    a->data = b->data;
+    a->dataSize = b->dataSize;
+    a->callback = b->callback;
+    a->context = b->context;
+    a->sequence = b->sequence;
+
+    b->key = entry.key;
+    b->keyBits = entry.keyBits;
+    b->data = entry.data;
+    b->dataSize = entry.dataSize;
+    b->callback = entry.callback;
+    b->context = entry.context;
+    b->sequence = entry.sequence;
+}
+
+static inline void batchEntrySift(RadixBatch *batch, size_t index, size_t count)
+{
+    while (true) {
+        size_t greatest = index;
+        size_t left = 2 * index + 1;
+        size_t right = 2 * index + 2;
+
+        if (left < count && batchEntryLess(batchEntry(batch, greatest), batchEntry(batch, left)))
+            greatest = left;
+
+        if (right < count && batchEntryLess(batchEntry(batch, greatest), batchEntry(batch, right)))
+            greatest = right;
+
+        if (greatest == index)
+            return;
+
+        batchEntrySwap(batchEntry(batch, index), batchEntry(batch, greatest));
+
+        index = greatest;
+    }
+}
+
+RadixBatch radixBatchCreate(RadixBatchEntry *entries, size_t capacity)
+{
+    RadixBatch batch = {
+        .entries = entries,
+        .capacity = capacity,
+        .head = 0,
+        .checkpoint = {0},
+    };
+
+    atomic_init(batchTail(&batch), 0);
+
+    // Entry is free for the push of its position, published when its turn is one more
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(batchTurn(&entries[i]), i);
+    }
+
+    return batch;
+}
+
+RadixError radixBatchPush(RadixBatch *batch, unsigned char *key, size_t keyBits, unsigned char *data, size_t dataSize, RadixBatchCallback callback, void *context)
+{
+    if (batch->capacity == 0)
+        return RADIX_OUT_OF_MEMORY;
+
+    size_t position = atomic_load_explicit(batchTail(batch), memory_order_relaxed);
+
+    RadixBatchEntry *entry;
+
+    // Claim the tail - the entry has to be free for this position (otherwise the queue is full or another producer was faster)
+    while (true) {
+        entry = &batch->entries[position % batch->capacity];
+
+        size_t turn = atomic_load_explicit(batchTurn(entry), memory_order_acquire);
+
+        if (turn == position) {
+            if (atomic_compare_exchange_weak_explicit(batchTail(batch), &position, position + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (turn - position > SIZE_MAX / 2) {
+            return RADIX_OUT_OF_MEMORY;
+        } else {
+            position = atomic_load_explicit(batchTail(batch), memory_order_relaxed);
+        }
+    }
+
+    entry->key = key;
+    entry->keyBits = keyBits;
+    entry->data = data;
+    entry->dataSize = dataSize;
+    entry->callback = callback;
+    entry->context = context;
+    entry->sequence = position;
+    entry->value = (RadixValue){0};
+
+    // Publish the entry for the writer
+    atomic_store_explicit(batchTurn(entry), position + 1, memory_order_release);
+
+    return RADIX_SUCCESS;
+}
+
+RadixError radixBatchApply(RadixBatch *batch, Radix *radix)
+{
+    // Take the published entries from the head (the first unpublished one ends them ..pushing order of the same key is kept)
+    size_t count = 0;
+
+    while (count < batch->capacity && atomic_load_explicit(batchTurn(&batch->entries[(batch->head + count) % batch->capacity]), memory_order_acquire) == batch->head + count + 1) {
+        count++;
+    }
+
+    // Sort entries by key (heap sort - it does not need any additional memory)
+    for (size_t i = count / 2; i > 0; i--) {
+        batchEntrySift(batch, i - 1, count);
+    }
+
+    for (size_t i = count; i > 1; i--) {
+        batchEntrySwap(batchEntry(batch, 0), batchEntry(batch, i - 1));
+
+        batchEntrySift(batch, 0, i - 1);
+    }
+
+    // Apply entries
+    Meta *meta = (Meta *)radix->memory;
+
+    batch->checkpoint = radixCheckpoint(radix);
+
+    RadixError error = RADIX_SUCCESS;
+
+    RadixFinger finger = radixFinger(radix, NULL, 0);
+
+    size_t applied = count;
+
+    for (size_t i = 0; i < count; i++) {
+        RadixBatchEntry *entry = batchEntry(batch, i);
+
+        // Sorted keys share their path with the previous key ..insert from their deepest common ancestor
+        if (radixIteratorIsEmpty(&finger.iterator)) {
+            entry->value = radixInsert(&finger.iterator, entry->key, entry->keyBits, entry->data, entry->dataSize);
+        } else {
+            size_t nodeKeyBits;
+
+            Node *node = fingerAncestor(radix, &finger, entry->key, entry->keyBits, &nodeKeyBits);
+
+            entry->value = insert(radix, node, entry->key, nodeKeyBits, entry->keyBits, ITEM_INLINE, entry->data, entry->dataSize, entry->dataSize, 0);
+        }
+
+        // Cache mode deletes removed keys physically ..their empty value means success
+        if (radixValueIsEmpty(&entry->value) && (meta->cache == 0 || entry->dataSize != 0)) {
+            error = RADIX_OUT_OF_MEMORY;
+            applied = i;
+
+            break;
+        }
+
+        // Cache mode releases nodes (removals, evictions) ..the next key is inserted from the head-node
+        if (meta->cache != 0)
+            continue;
+
+        Item *item = (Item *) (radix->memory + entry->value.item);
+
+        // Entries keep their keys until completion, so the finger does not need to copy them
+        finger.iterator.node = item->node;
+        finger.key = entry->key;
+        finger.keyBits = entry->keyBits;
+    }
+
+    // If batch could not be applied as a whole ..restore the state before the batch
+    if (error)
+        radixCheckpointRestore(radix, &batch->checkpoint);
+
+    // Complete entries (cache mode can not be restored ..entries applied before the error keep their values)
+    for (size_t i = 0; i < count; i++) {
+        RadixBatchEntry *entry = batchEntry(batch, i);
+
+        if (error && (meta->cache == 0 || i >= applied))
+            entry->value = radixValueIterator(radix);
+
+        if (entry->callback)
+            entry->callback(entry->context, &entry->value);
+
+        // Free the entry for the push one round later
+        atomic_store_explicit(batchTurn(entry), batch->head + i + batch->capacity, memory_order_release);
+    }
+
+    batch->head += count;
+
+    return error;
+}
+
+RadixError radixFilterRebuild(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->filter == 0)
+        return RADIX_SUCCESS;
+
+    unsigned char *filter = radix->memory + meta->filter;
+
+    for (size_t i = 0; i < meta->filterBlocks * RADIX_FILTER_BLOCK_SIZE; i++) {
+        filter[i] = 0;
+    }
+
+    meta->filterKeys = 0;
+
+    // Add keys of all nodes with items (keys are copied to the free memory)
+    for (size_t nodeAddress = meta->lastNode; nodeAddress != 0;) {
+        Node *node = (Node *) (radix->memory + nodeAddress);
+
+        if (node->item != 0) {
+            RadixIterator nodeIterator = { .radix = radix, .node = nodeAddress };
+
+            size_t nodeKeyBits = radixKeyBits(&nodeIterator);
+
+            if ((nodeKeyBits + CHAR_BIT - 1) / CHAR_BIT > radix->memorySize - meta->structureEnd)
+                return RADIX_OUT_OF_MEMORY;
+
+            unsigned char *nodeKey = radix->memory + meta->structureEnd;
+
+            radixKeyCopy(&nodeIterator, nodeKey, nodeKeyBits);
+
+            filterAdd(radix, keyHash(nodeKey, nodeKeyBits));
+        }
+
+        nodeAddress = node->lastNode;
+    }
+
+    return RADIX_SUCCESS;
+}
+
+RadixFilterStats radixFilterStats(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixFilterStats result = {0};
+
+    if (meta->filter == 0)
+        return result;
+
+    result.bits = meta->filterBlocks * RADIX_FILTER_BLOCK_SIZE * CHAR_BIT;
+    result.keys = meta->filterKeys;
+
+    // False positive rate is the mean (over blocks) probability that all probed bits are set
+    for (size_t block = 0; block < meta->filterBlocks; block++) {
+        uint64_t *words = (uint64_t *) (radix->memory + meta->filter + block * RADIX_FILTER_BLOCK_SIZE);
+
+        size_t blockBitsSet = 0;
+
+        for (size_t i = 0; i < RADIX_FILTER_BLOCK_SIZE / sizeof(uint64_t); i++) {
+            for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+                blockBitsSet++;
+            }
+        }
+
+        double fill = (double)blockBitsSet / (RADIX_FILTER_BLOCK_SIZE * CHAR_BIT);
+        double rate = 1;
+
+        for (size_t i = 0; i < RADIX_FILTER_PROBES; i++) {
+            rate *= fill;
+        }
+
+        result.bitsSet += blockBitsSet;
+        result.falsePositiveRate += rate / meta->filterBlocks;
+    }
+
+    return result;
+}
+
+RadixCounters radixCounters(void)
+{
+#ifdef RADIX_STATS
+    return counters;
+#else
+    return (RadixCounters) {0};
+#endif
+}
+
+void radixCountersReset(void)
+{
+#ifdef RADIX_STATS
+    counters = (RadixCounters) {0};
+#endif
+}
+
+// Returns the statistics of the frozen structure (the walk visits records in the key order)
+static RadixStats frozenStats(Radix *radix, bool walk)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    RadixStats result = {0};
+
+    if (!walk) {
+        result.nodes = meta->nodeCount;
+        result.items = meta->itemCount;
+        result.liveItems = meta->liveCount;
+        result.keyBytes = meta->keyBytes;
+        result.valueBytes = meta->valueBytes;
+    } else {
+        size_t depthSum = 0;
+
+        for (size_t address = sizeof(Meta); address < meta->structureEnd;) {
+            FrozenRecord record = frozenRecord(radix, address);
+
+            result.nodes++;
+            result.keyBytes += (record.keyBits + CHAR_BIT - 1) / CHAR_BIT;
+
+            if (record.flags & FROZEN_VALUE) {
+                result.items++;
+                result.liveItems++;
+                result.valueBytes += record.dataSize;
+
+                // Depth is the number of records on the path from the root
+                size_t depth = 0;
+
+                for (size_t ancestor = sizeof(Meta); ancestor != address; depth++) {
+                    FrozenRecord ancestorRecord = frozenRecord(radix, ancestor);
+
+                    ancestor = frozenToward(&ancestorRecord, address);
+                }
+
+                result.depths[depth < RADIX_STATS_DEPTHS ? depth : RADIX_STATS_DEPTHS - 1]++;
+                depthSum += depth;
+
+                if (depth > result.maxDepth)
+                    result.maxDepth = depth;
+            }
+
+            address = record.end;
+        }
+
+        result.averageDepth = result.liveItems != 0 ? (double)depthSum / result.liveItems : 0;
+    }
+
+    FrozenRecord root = frozenRecord(radix, sizeof(Meta));
+
+    // Records without values (the root record is not created by a split)
+    result.splitNodes = result.nodes - 1 - result.liveItems + ((root.flags & FROZEN_VALUE) != 0);
+    result.splitRatio = result.nodes > 1 ? (double)result.splitNodes / (result.nodes - 1) : 0;
+
+    return result;
+}
+
+RadixStats radixStats(Radix *radix, bool walk)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->frozen)
+        return frozenStats(radix, walk);
+
+    RadixStats result = {0};
+
+    if (meta->lastNode == 0)
+        return result;
+
+    Node *head = (Node *) (radix->memory + sizeof(Meta));
+
+    result.evictions = meta->cacheEvictions;
+
+    if (!walk) {
+        result.nodes = meta->nodeCount;
+        result.items = meta->itemCount;
+        result.liveItems = meta->liveCount;
+        result.nullItems = meta->nullCount;
+        result.keyBytes = meta->keyBytes;
+        result.valueBytes = meta->valueBytes;
+        result.deadBytes = meta->deadBytes;
+
+        // Nodes without items (the head-node is not created by a split)
+        result.splitNodes = result.nodes - 1 - result.liveItems - result.nullItems + (head->item != 0);
+    } else {
+        size_t depthSum = 0;
+
+        // Visit nodes in the key order (depth-first without a stack, the way back leads through parents)
+        Node *node = head;
+        size_t depth = 0;
+
+        while (node) {
+            result.nodes++;
+            result.keyBytes += nodeKeyMemory(radix, node);
+
+            if (node->item == 0 && node != head)
+                result.splitNodes++;
+
+            // Visit node items (from the latest)
+            for (size_t itemAddress = node->item; itemAddress != 0;) {
+                Item *item = (Item *) (radix->memory + itemAddress);
+
+                result.items++;
+                result.valueBytes += itemSize(item);
+
+                if (itemAddress != node->item) {
+                    result.deadBytes += itemMemory(meta, item);
+                } else if (itemSize(item) > 0) {
+                    result.liveItems++;
+
+                    result.depths[depth < RADIX_STATS_DEPTHS ? depth : RADIX_STATS_DEPTHS - 1]++;
+                    depthSum += depth;
+
+                    if (depth > result.maxDepth)
+                        result.maxDepth = depth;
+                } else {
+                    result.nullItems++;
+                    result.deadBytes += itemMemory(meta, item);
+                }
+
+                itemAddress = item->previous;
+            }
+
+            // Go to the first child
+            size_t childAddress = node->childSmaller != 0 ? node->childSmaller : node->childGreater;
+
+            if (childAddress != 0) {
+                node = (Node *) (radix->memory + childAddress);
+                depth++;
+                continue;
+            }
+
+            // Go back to the first parent with the unvisited greater child
+            for (; node != head; depth--) {
+                size_t nodeAddress = (unsigned char *)node - radix->memory;
+
+                Node *parent = (Node *) (radix->memory + node->parent);
+
+                if (parent->childSmaller == nodeAddress && parent->childGreater != 0) {
+                    node = (Node *) (radix->memory + parent->childGreater);
+                    break;
+                }
+
+                node = parent;
+            }
+
+            if (node == head)
+                node = NULL;
+        }
+
+        result.averageDepth = result.liveItems != 0 ? (double)depthSum / result.liveItems : 0;
+    }
+
+    result.shadowedItems = result.items - result.liveItems - result.nullItems;
+    result.splitRatio = result.nodes > 1 ? (double)result.splitNodes / (result.nodes - 1) : 0;
+
+    return result;
+}
+
+// Returns whether the subtree of the node has values visible at the time of the freeze
+static bool freezeLive(Radix *radix, size_t nodeAddress, uint64_t time)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    if (liveChild(radix, nodeAddress) == 0)
+        return false;
+
+    // Visible values flags do not know about expiry
+    if (meta->expiry == 0)
+        return true;
+
+    // Visit the subtree depth-first without a stack (the way back leads through parents)
+    Node *root = (Node *) (radix->memory + nodeAddress);
+
+    for (Node *node = root; node;) {
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        if (itemVisible(radix, item, time))
+            return true;
+
+        size_t childAddress = liveChild(radix, node->childSmaller) != 0 ? node->childSmaller : liveChild(radix, node->childGreater);
+
+        if (childAddress != 0) {
+            node = (Node *) (radix->memory + childAddress);
+            continue;
+        }
+
+        while (node != root) {
+            size_t address = (unsigned char *)node - radix->memory;
+
+            Node *parent = (Node *) (radix->memory + node->parent);
+
+            if (parent->childSmaller == address && liveChild(radix, parent->childGreater) != 0) {
+                node = (Node *) (radix->memory + parent->childGreater);
+                break;
+            }
+
+            node = parent;
+        }
+
+        if (node == root)
+            node = NULL;
+    }
+
+    return false;
+}
+
+// Returns whether the size fits the frozen structure memory after the position
+static inline bool freezeFits(Radix *frozen, size_t position, size_t size)
+{
+    return position <= frozen->memorySize && size <= frozen->memorySize - position;
+}
+
+// Writes the records of the visible values (depth-first, nodes with one child and no value are merged
+// with the child) - returns the end of the records (0 - out of memory or corrupted data)
+static size_t freezeRecords(Radix *radix, Radix *frozen, uint64_t time)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    unsigned char *memory = frozen->memory;
+
+    size_t record = sizeof(Meta);
+
+    // Edge of the record is gathered after the longest header (merged nodes extend it)
+    size_t edgeBits = 0;
+
+    // Placeholders of the greater child offsets are chained (each one stores the distance to the previous one)
+    size_t patch = 0;
+
+    Node *head = (Node *) (radix->memory + sizeof(Meta));
+    Node *node = meta->lastNode != 0 ? head : NULL;
+
+    if (!freezeFits(frozen, record, RADIX_FROZEN_HEADER_SIZE))
+        return 0;
+
+    while (node) {
+        size_t nodeKeyBits = CHAR_BIT * (node->keyRear - node->keyFore) + node->keyRearOffset - node->keyForeOffset;
+
+        if (!freezeFits(frozen, record + RADIX_FROZEN_HEADER_SIZE, (edgeBits + nodeKeyBits + CHAR_BIT - 1) / CHAR_BIT))
+            return 0;
+
+        bitCopy(radix->memory + node->keyFore, node->keyForeOffset, memory + record + RADIX_FROZEN_HEADER_SIZE, edgeBits, nodeKeyBits);
+
+        edgeBits += nodeKeyBits;
+
+        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+
+        bool value = itemVisible(radix, item, time);
+        bool smaller = freezeLive(radix, node->childSmaller, time);
+        bool greater = freezeLive(radix, node->childGreater, time);
+
+        // Node without a value and with one child is merged with the child (the root record is kept)
+        if (!value && smaller != greater && node != head) {
+            node = (Node *) (radix->memory + (smaller ? node->childSmaller : node->childGreater));
+            continue;
+        }
+
+        size_t position = record;
+
+        memory[position++] = (unsigned char)((value ? FROZEN_VALUE : 0) | (smaller ? FROZEN_SMALLER : 0) | (greater ? FROZEN_GREATER : 0));
+
+        if (smaller && greater) {
+            if (patch != 0 && position - patch > UINT32_MAX)
+                return 0;
+
+            frozenOffsetWrite(memory + position, patch != 0 ? position - patch : 0);
+
+            patch = position;
+            position += RADIX_FROZEN_OFFSET_SIZE;
+        }
+
+        // Edge is moved right after the header (the number never reaches the gathered edge)
+        size_t edgeSize = (edgeBits + CHAR_BIT - 1) / CHAR_BIT;
+
+        position += frozenNumberWrite(memory + position, edgeBits);
+
+        byteCopy(memory + position, memory + record + RADIX_FROZEN_HEADER_SIZE, edgeSize);
+
+        // Bits after the edge are cleared, so the copy does not depend on the memory it was written to
+        if (edgeBits % CHAR_BIT != 0)
+            memory[position + edgeSize - 1] &= (unsigned char)(0xff << (CHAR_BIT - edgeBits % CHAR_BIT));
+
+        position += edgeSize;
+
+        if (value) {
+            size_t dataSize = itemSize(item);
+
+            if (!freezeFits(frozen, position, RADIX_FROZEN_NUMBER_SIZE) || !freezeFits(frozen, position + RADIX_FROZEN_NUMBER_SIZE, dataSize))
+                return 0;
+
+            position += frozenNumberWrite(memory + position, dataSize);
+
+            // Data is copied (referenced and logged data too) and decompressed
+            if (itemKind(item) == ITEM_COMPRESSED) {
+                ItemCompressed *compressed = (ItemCompressed *) itemStorage(item);
+
+                if (!decompress((unsigned char *)compressed + sizeof(ItemCompressed), compressed->size, memory + position, dataSize))
+                    return 0;
+            } else {
+                byteCopy(memory + position, itemData(radix, item), dataSize);
+            }
+
+            position += dataSize;
+        }
+
+        Meta *frozenMeta = (Meta *)memory;
+
+        frozenMeta->nodeCount++;
+        frozenMeta->keyBytes += edgeSize;
+
+        if (value) {
+            frozenMeta->itemCount++;
+            frozenMeta->liveCount++;
+            frozenMeta->valueBytes += itemSize(item);
+        }
+
+        record = position;
+        edgeBits = 0;
+
+        if (!freezeFits(frozen, record, RADIX_FROZEN_HEADER_SIZE))
+            return 0;
+
+        // Go to the first child (it follows the record)
+        if (smaller || greater) {
+            node = (Node *) (radix->memory + (smaller ? node->childSmaller : node->childGreater));
+            continue;
+        }
+
+        // Go back to the first parent with the unvisited greater child, its record is the latest one waiting for the offset
+        while (node != head) {
+            size_t nodeAddress = (unsigned char *)node - radix->memory;
+
+            Node *parent = (Node *) (radix->memory + node->parent);
+
+            if (parent->childSmaller == nodeAddress && freezeLive(radix, parent->childGreater, time)) {
+                size_t link = frozenOffsetRead(memory + patch);
+
+                // Offset is relative to the parent record (the placeholder follows its flags)
+                if (record - (patch - 1) > UINT32_MAX)
+                    return 0;
+
+                frozenOffsetWrite(memory + patch, record - (patch - 1));
+
+                patch = link != 0 ? patch - link : 0;
+
+                node = (Node *) (radix->memory + parent->childGreater);
+                break;
+            }
+
+            node = parent;
+        }
+
+        if (node == head)
+            node = NULL;
+    }
+
+    // Empty structure is the root record without a value and children
+    if (record == sizeof(Meta)) {
+        memory[record++] = 0;
+        record += frozenNumberWrite(memory + record, 0);
+    }
+
+    return record;
+}
+
+RadixError radixFreeze(Radix *radix, Radix *frozen)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    // Frozen structure is copied as is
+    if (meta->frozen) {
+        if (meta->structureEnd > frozen->memorySize)
+            return RADIX_OUT_OF_MEMORY;
+
+        byteCopy(frozen->memory, radix->memory, meta->structureEnd);
+
+        return RADIX_SUCCESS;
+    }
+
+    if (radixClear(frozen) != RADIX_SUCCESS)
+        return RADIX_OUT_OF_MEMORY;
+
+    size_t structureEnd = freezeRecords(radix, frozen, itemTime(radix));
+
+    if (structureEnd == 0) {
+        radixClear(frozen);
+
+        return RADIX_OUT_OF_MEMORY;
+    }
+
+    Meta *frozenMeta = (Meta *)frozen->memory;
+
+    // Frozen structure has no head-node, so the functions not reading records find it empty
+    frozenMeta->structureEnd = structureEnd;
+    frozenMeta->frozen = true;
+
+    return RADIX_SUCCESS;
+}
+
+static const uint32_t crcTable[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c, 0x26a1e7e8, 0xd4ca64eb,
+    0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b, 0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24,
+    0x105ec76f, 0xe235446c, 0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc, 0xbc267848, 0x4e4dfb4b,
+    0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a, 0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35,
+    0xaa64d611, 0x580f5512, 0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad, 0x1642ae59, 0xe4292d5a,
+    0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a, 0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595,
+    0x417b1dbc, 0xb3109ebf, 0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f, 0xed03a29b, 0x1f682198,
+    0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927, 0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38,
+    0xdbfc821c, 0x2997011f, 0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e, 0x4767748a, 0xb50cf789,
+    0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859, 0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46,
+    0x7198540d, 0x83f3d70e, 0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de, 0xdde0eb2a, 0x2f8b6829,
+    0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c, 0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93,
+    0x082f63b7, 0xfa44e0b4, 0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b, 0xb4091bff, 0x466298fc,
+    0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c, 0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033,
+    0xa24bb5a6, 0x502036a5, 0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975, 0x0e330a81, 0xfc588982,
+    0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d, 0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622,
+    0x38cc2a06, 0xcaa7a905, 0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8, 0xe52cc12c, 0x1747422f,
+    0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff, 0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0,
+    0xd3d3e1ab, 0x21b862a8, 0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78, 0x7fab5e8c, 0x8dc0dd8f,
+    0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee, 0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1,
+    0x69e9f0d5, 0x9b8273d6, 0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69, 0xd5cf889d, 0x27a40b9e,
+    0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e, 0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351,
+};
+
+static uint32_t crc32c(uint32_t crc, const unsigned char *data, size_t size)
+{
+    crc = ~crc;
+
+#ifdef RADIX_CRC32C_WORD
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+        uint64_t word;
+
+        byteCopy((unsigned char *)&word, data, sizeof(uint64_t));
+
+        crc = RADIX_CRC32C_WORD(crc, word);
+    }
+#endif
+
+    for (; size > 0; size--, data++) {
+        crc = crcTable[(crc ^ *data) & 0xff] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+static inline void imageWrite(unsigned char *output, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        output[i] = (unsigned char) (value >> (CHAR_BIT * i));
+    }
+}
+
+static inline uint64_t imageRead(const unsigned char *input, size_t size)
+{
+    uint64_t value = 0;
+
+    for (size_t i = size; i-- > 0;) {
+        value = value << CHAR_BIT | input[i];
+    }
+
+    return value;
+}
+
+// Writes the layout of the structure memory built by this compiler and target
+// Writes the layout bytes, frozen structures have no nodes and items (their sizes are zero)
+static void imageLayout(unsigned char *layout, bool frozen)
+{
+    // Byte order and bitfield order are found by probes
+    Offset offsetProbe = 1;
+
+    Node nodeProbe;
+
+    for (size_t i = 0; i < sizeof(Node); i++) {
+        ((unsigned char *)&nodeProbe)[i] = 0;
+    }
+
+    nodeProbe.keyForeOffset = 1;
+
+    size_t bitfieldByte = 0;
+
+    while (bitfieldByte + 1 < sizeof(Node) && ((unsigned char *)&nodeProbe)[bitfieldByte] == 0) {
+        bitfieldByte++;
+    }
+
+    layout[0] = *(unsigned char *)&offsetProbe != 1;
+    layout[1] = ((unsigned char *)&nodeProbe)[bitfieldByte] != 1;
+    layout[2] = sizeof(Offset);
+    layout[3] = sizeof(size_t);
+    layout[4] = sizeof(void *);
+    layout[5] = bitfieldByte;
+
+    imageWrite(layout + 6, frozen ? 0 : sizeof(Node), 2);
+    imageWrite(layout + 8, frozen ? 0 : sizeof(Item), 2);
+    imageWrite(layout + 10, sizeof(Meta), 2);
+    imageWrite(layout + 12, offsetof(Node, childSmaller), 2);
+    imageWrite(layout + 14, offsetof(Node, childGreater), 2);
+    imageWrite(layout + 16, offsetof(Node, keyFore), 2);
+    imageWrite(layout + 18, offsetof(Node, keyRear), 2);
+    imageWrite(layout + 20, offsetof(Node, item), 2);
+    imageWrite(layout + 22, offsetof(Node, parent), 2);
+    imageWrite(layout + 24, offsetof(Item, size), 2);
+    imageWrite(layout + 26, offsetof(Item, node), 2);
+}
+
+static inline size_t imageUsage(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    // Memory of the structure that has not been managed yet is the cleared meta
+    return meta->structureEnd > sizeof(Meta) ? meta->structureEnd : sizeof(Meta);
+}
+
+// Returns whether all items are stored in the structure memory (no referenced data and no value log)
+static bool imageExportable(Radix *radix)
+{
+    Meta *meta = (Meta *)radix->memory;
+
+    if (meta->lastNode == 0)
+        return true;
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    if (meta->valueLogEnd != 0)
+        return false;
 
-            return result;
-        }
-    }
+    Node *head = (Node *) (radix->memory + sizeof(Meta));
 
-    // Move to smaller (shorter < longer)
-    // Priority:
-    // 1: parent-child-child (leaf child)
-    // 2: parent-child
-    // 3: parent
-    //   no parent - return empty iterator
-    while (true) {
-        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    // Visit nodes depth-first without a stack (the way back leads through parents)
+    for (Node *node = head; node;) {
+        for (size_t itemAddress = node->item; itemAddress != 0;) {
+            Item *item = (Item *) (radix->memory + itemAddress);
 
-        // "no parent"
-        if (!parentNode)
-            return result;
+            if (itemKind(item) == ITEM_REFERENCE || itemKind(item) == ITEM_LOG)
+                return false;
 
-        if (parentNode->childSmaller != 0 && parentNode->childSmaller != (unsigned char*)node - radix->memory) {
-            node = (Node *) (radix->memory + parentNode->childSmaller);
+            itemAddress = item->previous;
+        }
 
-            // Move to "parent-child-child" or "parent-child"
-            while (node->childSmaller != 0 || node->childGreater != 0) {
-                node = (Node *) (radix->memory + (node->childGreater != 0 ? node->childGreater : node->childSmaller));
-            }
-        } else {
-            // Move to "parent"
-            node = parentNode;
+        size_t childAddress = node->childSmaller != 0 ? node->childSmaller : node->childGreater;
+
+        if (childAddress != 0) {
+            node = (Node *) (radix->memory + childAddress);
+            continue;
         }
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+        while (node != head) {
+            size_t nodeAddress = (unsigned char *)node - radix->memory;
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+            Node *parent = (Node *) (radix->memory + node->parent);
 
-            return result;
+            if (parent->childSmaller == nodeAddress && parent->childGreater != 0) {
+                node = (Node *) (radix->memory + parent->childGreater);
+                break;
+            }
+
+            node = parent;
         }
+
+        if (node == head)
+            node = NULL;
     }
+
+    return true;
 }
 
-RadixIterator radixNext(RadixIterator *iterator)
+size_t radixExportSize(Radix *radix)
 {
-    Radix *radix = iterator->radix;
+    size_t usage = imageUsage(radix);
 
-    Meta *meta = (Meta *)radix->memory;
+    return RADIX_IMAGE_HEADER_SIZE + (usage + RADIX_IMAGE_BLOCK_SIZE - 1) / RADIX_IMAGE_BLOCK_SIZE * sizeof(uint32_t) + usage;
+}
 
-    RadixIterator result = {0};
+RadixError radixExport(Radix *radix, unsigned char *output, size_t outputSize)
+{
+    size_t usage = imageUsage(radix);
+    size_t blocks = (usage + RADIX_IMAGE_BLOCK_SIZE - 1) / RADIX_IMAGE_BLOCK_SIZE;
 
-    result.radix = radix;
+    if (outputSize < radixExportSize(radix))
+        return RADIX_OUT_OF_MEMORY;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    if (!imageExportable(radix))
+        return RADIX_INVALID_ARGUMENT;
 
-    // If node is null, this means we should start with the smallest first of all nodes
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+    unsigned char *checksums = output + RADIX_IMAGE_HEADER_SIZE;
+    unsigned char *image = checksums + blocks * sizeof(uint32_t);
 
-        // Retrieve head-node - this is smallest first of all nodes
-        node = (Node *) (radix->memory + sizeof(Meta));
+    // Write header
+    byteCopy(output, (const unsigned char *)"RDXI", 4);
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    imageWrite(output + 4, RADIX_IMAGE_VERSION, 2);
+    imageWrite(output + 6, RADIX_IMAGE_HEADER_SIZE, 2);
 
-        // If matched node has item (not nullable) - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    imageLayout(output + RADIX_IMAGE_LAYOUT_FORE, ((Meta *)radix->memory)->frozen);
 
-            return result;
-        }
+    imageWrite(output + 36, RADIX_IMAGE_BLOCK_SIZE, 4);
+    imageWrite(output + 40, usage, 8);
+
+    // Items are preceded by their expiry and version (expiry is the first one)
+    Meta *meta = (Meta *)radix->memory;
+
+    imageWrite(output + 48, itemPrefixSize(meta), 2);
+    imageWrite(output + 50, meta->expiry != 0, 2);
+
+    // Write blocks with their checksums
+    for (size_t block = 0; block < blocks; block++) {
+        size_t blockFore = block * RADIX_IMAGE_BLOCK_SIZE;
+        size_t blockSize = usage - blockFore < RADIX_IMAGE_BLOCK_SIZE ? usage - blockFore : RADIX_IMAGE_BLOCK_SIZE;
+
+        byteCopy(image + blockFore, radix->memory + blockFore, blockSize);
+
+        imageWrite(checksums + block * sizeof(uint32_t), crc32c(0, image + blockFore, blockSize), sizeof(uint32_t));
     }
 
-    // Move to greater (shorter < longer)
-    // Priority:
-    // 1. child
-    // 2. parent-child
-    // 3. parent-parent-child
-    //   no parent - return empty iterator
-    while (true) {
-        // Move to "child"
-        if (node->childSmaller != 0 || node->childGreater != 0) {
-            node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
+    // Header checksum covers the block checksums too
+    uint32_t checksum = crc32c(crc32c(0, output, 52), checksums, blocks * sizeof(uint32_t));
 
-            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    imageWrite(output + 52, checksum, sizeof(uint32_t));
 
-            // If matched node has item (not nullable) - this is the object you are looking for
-            if (item && item->size > 0) {
-                result.node = (unsigned char *)node - radix->memory;
-                result.data = (unsigned char*)item + sizeof(Item);
-                result.dataSize = item->size;
+    return RADIX_SUCCESS;
+}
 
-                return result;
-            }
+typedef struct ImageLayout {
+    bool bigEndian;
+    bool bitfieldsFromTop;
 
-            continue;
-        }
+    size_t offsetSize;
+    size_t sizeSize;
+    size_t bitfieldByte;
 
-        // Move to "parent-child" or "parent-parent-child"
-        while (true) {
-            Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    size_t nodeSize;
+    size_t itemSize;
+    size_t metaSize;
 
-            // "no parent"
-            if (!parentNode)
-                return result;
+    size_t childSmaller;
+    size_t childGreater;
+    size_t keyFore;
+    size_t keyRear;
+    size_t item;
+    size_t parent;
 
-            if (parentNode->childGreater != 0 && parentNode->childGreater != (unsigned char*)node - radix->memory) {
-                node = (Node *) (radix->memory + parentNode->childGreater);
+    size_t itemSizeField;
 
-                break;
-            }
+    // Stores the size of memory before items and whether it starts with the expiry
+    size_t itemPrefix;
+    bool itemExpiry;
+} ImageLayout;
 
-            node = parentNode;
-        }
+typedef struct ImageNode {
+    size_t childSmaller;
+    size_t childGreater;
+    size_t keyFore;
+    size_t keyRear;
+    size_t keyForeOffset;
+    size_t keyRearOffset;
+    size_t keyBits;
+    size_t item;
+    size_t parent;
+} ImageNode;
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+// Reads the number of the other layout (false - out of the image)
+static inline bool imageNumber(ImageLayout *layout, unsigned char *image, size_t imageSize, size_t address, size_t size, uint64_t *value)
+{
+    if (address > imageSize || size > imageSize - address)
+        return false;
 
-        // If matched node has item (not nullable) - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    *value = 0;
 
-            return result;
-        }
+    for (size_t i = 0; i < size; i++) {
+        *value = *value << CHAR_BIT | image[address + (layout->bigEndian ? i : size - 1 - i)];
     }
+
+    return true;
 }
 
-RadixIterator radixNextNullable(RadixIterator *iterator)
+// Reads the address or size of the other layout (false - out of the image)
+static inline bool imageField(ImageLayout *layout, unsigned char *image, size_t imageSize, size_t address, size_t size, size_t *value)
 {
-    Radix *radix = iterator->radix;
+    uint64_t number;
 
-    Meta *meta = (Meta *)radix->memory;
+    if (!imageNumber(layout, image, imageSize, address, size, &number) || number > imageSize)
+        return false;
 
-    RadixIterator result = {0};
+    *value = (size_t)number;
 
-    result.radix = radix;
+    return true;
+}
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+static inline bool imageNode(ImageLayout *layout, unsigned char *image, size_t imageSize, size_t address, ImageNode *node)
+{
+    if (address > imageSize || layout->nodeSize > imageSize - address)
+        return false;
 
-    // If node is null, this means we should start with the smallest first of all nodes
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+    size_t offsetSize = layout->offsetSize;
 
-        // Retrieve head-node - this is smallest first of all nodes
-        node = (Node *) (radix->memory + sizeof(Meta));
+    if (!imageField(layout, image, imageSize, address + layout->childSmaller, offsetSize, &node->childSmaller) ||
+        !imageField(layout, image, imageSize, address + layout->childGreater, offsetSize, &node->childGreater) ||
+        !imageField(layout, image, imageSize, address + layout->keyFore, offsetSize, &node->keyFore) ||
+        !imageField(layout, image, imageSize, address + layout->keyRear, offsetSize, &node->keyRear) ||
+        !imageField(layout, image, imageSize, address + layout->item, offsetSize, &node->item) ||
+        !imageField(layout, image, imageSize, address + layout->parent, offsetSize, &node->parent))
+        return false;
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    unsigned char bitfield = image[address + layout->bitfieldByte];
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    // Bit offsets are the first two 3-bit fields
+    node->keyForeOffset = layout->bitfieldsFromTop ? bitfield >> 5 : bitfield & 7;
+    node->keyRearOffset = layout->bitfieldsFromTop ? (bitfield >> 2) & 7 : (bitfield >> 3) & 7;
 
-            return result;
-        }
-    }
+    if (node->keyRear < node->keyFore || (node->keyRear == node->keyFore && node->keyRearOffset < node->keyForeOffset) || node->keyRear + (node->keyRearOffset != 0) > imageSize)
+        return false;
 
-    // Move to greater (shorter < longer)
-    // Priority:
-    // 1. child
-    // 2. parent-child
-    // 3. parent-parent-child
-    //   no parent - return empty iterator
-    while (true) {
-        // Move to "child"
-        if (node->childSmaller != 0 || node->childGreater != 0) {
-            node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
+    node->keyBits = CHAR_BIT * (node->keyRear - node->keyFore) + node->keyRearOffset - node->keyForeOffset;
 
-            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    return true;
+}
 
-            // If matched node has item (nullable) - this is the object you are looking for
-            if (item) {
-                result.node = (unsigned char *)node - radix->memory;
-                result.data = (unsigned char*)item + sizeof(Item);
-                result.dataSize = item->size;
+// Inserts the latest values of the image of the other layout visible at the time, with their expiry
+// (without the target, only the scratch memory and the expiring values are measured)
+static RadixError imageReplay(Radix *target, ImageLayout *layout, unsigned char *image, size_t imageSize, uint64_t time, unsigned char *scratch, size_t *keyMemory, size_t *storageMemory, size_t *expiring)
+{
+    size_t lastNode;
 
-                return result;
-            }
+    // Meta starts with the last node, the structure without nodes has not been managed yet
+    if (!imageField(layout, image, imageSize, 0, layout->sizeSize, &lastNode))
+        return RADIX_INVALID_ARGUMENT;
 
-            continue;
-        }
+    if (lastNode == 0)
+        return RADIX_SUCCESS;
 
-        // Move to "parent-child" or "parent-parent-child"
-        while (true) {
-            Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    size_t headAddress = layout->metaSize;
+    size_t nodeAddress = headAddress;
 
-            // "no parent"
-            if (!parentNode)
-                return result;
+    ImageNode node;
 
-            if (parentNode->childGreater != 0 && parentNode->childGreater != (unsigned char*)node - radix->memory) {
-                node = (Node *) (radix->memory + parentNode->childGreater);
+    if (!imageNode(layout, image, imageSize, nodeAddress, &node))
+        return RADIX_INVALID_ARGUMENT;
 
-                break;
-            }
+    size_t keyBits = 0;
 
-            node = parentNode;
-        }
+    // Damaged links must not loop forever (every node is visited at most three times)
+    size_t steps = 3 * (imageSize / layout->nodeSize + 1);
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    RadixIterator iterator = target ? radixIterator(target) : (RadixIterator) {0};
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    while (true) {
+        if (steps-- == 0)
+            return RADIX_INVALID_ARGUMENT;
 
-            return result;
-        }
-    }
-}
+        // Key of the node is kept in the scratch memory
+        if ((keyBits + CHAR_BIT - 1) / CHAR_BIT > *keyMemory && !target)
+            *keyMemory = (keyBits + CHAR_BIT - 1) / CHAR_BIT;
 
-RadixIterator radixPrevInverse(RadixIterator *iterator)
-{
-    Radix *radix = iterator->radix;
+        if (node.item != 0) {
+            uint64_t sizeField;
 
-    Meta *meta = (Meta *)radix->memory;
+            // Item size stores the data kind in its top bits
+            if (!imageNumber(layout, image, imageSize, node.item + layout->itemSizeField, layout->offsetSize, &sizeField))
+                return RADIX_INVALID_ARGUMENT;
 
-    RadixIterator result = {0};
+            size_t kindShift = layout->offsetSize * CHAR_BIT - ITEM_KIND_BITS;
 
-    result.radix = radix;
+            ItemKind kind = (ItemKind) (sizeField >> kindShift);
+            size_t dataSize = (size_t) (sizeField & (((uint64_t)1 << kindShift) - 1));
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+            size_t storageAddress = node.item + layout->itemSize;
 
-    // if node is null - start iteration by finding the greatest first of all nodes
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+            unsigned char *storage = NULL;
+            size_t storageSize = 0;
 
-        // Retrieve head-node - this is greatest first of all nodes
-        node = (Node *) (radix->memory + sizeof(Meta));
+            uint64_t expires = 0;
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+            // Values expired at the time are not inserted, the others keep expiring
+            if (dataSize != 0 && layout->itemExpiry) {
+                if (node.item < layout->itemPrefix || !imageNumber(layout, image, imageSize, node.item - layout->itemPrefix, sizeof(uint64_t), &expires))
+                    return RADIX_INVALID_ARGUMENT;
 
-        // If matched node has item not nullable - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+                if (expires != 0 && time >= expires)
+                    dataSize = 0;
+                else if (expires != 0 && !target)
+                    (*expiring)++;
+            }
 
-            return result;
-        }
-    }
+            if (dataSize != 0) {
+                // Shared data is stored by the older inline item
+                if (kind == ITEM_SHARED) {
+                    size_t sharedItem;
 
-    // Move to smaller (longer < shorter)
-    // Priority:
-    // 1. child
-    // 2. parent-child
-    // 3. parent-parent-child
-    //   no parent - return empty iterator
-    while (true) {
-        // move to "child"
-        if (node->childGreater != 0 || node->childSmaller != 0) {
-            node = (Node *) (radix->memory + (node->childGreater != 0 ? node->childGreater : node->childSmaller));
+                    if (!imageField(layout, image, imageSize, storageAddress, layout->offsetSize, &sharedItem))
+                        return RADIX_INVALID_ARGUMENT;
 
-            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+                    kind = ITEM_INLINE;
+                    storageAddress = sharedItem + layout->itemSize;
+                }
 
-            // If matched node has item not nullable - this is the object you are looking for
-            if (item && item->size > 0) {
-                result.node = (unsigned char *)node - radix->memory;
-                result.data = (unsigned char*)item + sizeof(Item);
-                result.dataSize = item->size;
+                if (kind == ITEM_INLINE) {
+                    if (storageAddress > imageSize || dataSize > imageSize - storageAddress)
+                        return RADIX_INVALID_ARGUMENT;
 
-                return result;
+                    storage = image + storageAddress;
+                    storageSize = dataSize;
+                } else if (kind == ITEM_COMPRESSED) {
+                    size_t compressedSize;
+
+                    if (!imageField(layout, image, imageSize, storageAddress, layout->offsetSize, &compressedSize) || compressedSize > imageSize - storageAddress - layout->offsetSize)
+                        return RADIX_INVALID_ARGUMENT;
+
+                    // Compressed data is preceded by its local header in the scratch memory
+                    storageSize = sizeof(ItemCompressed) + compressedSize;
+
+                    if (!target && storageSize > *storageMemory)
+                        *storageMemory = storageSize;
+
+                    if (target) {
+                        storage = scratch + *keyMemory;
+
+                        *(ItemCompressed *)storage = (ItemCompressed) { .size = compressedSize };
+
+                        byteCopy(storage + sizeof(ItemCompressed), image + storageAddress + layout->offsetSize, compressedSize);
+                    }
+                } else {
+                    return RADIX_INVALID_ARGUMENT;
+                }
             }
 
-            continue;
+            if (target && dataSize != 0) {
+                Node *head = insertStart(&iterator);
+
+                if (!head)
+                    return RADIX_OUT_OF_MEMORY;
+
+                RadixValue value = insert(target, head, scratch, 0, keyBits, kind, storage, storageSize, dataSize, expires);
+
+                if (radixValueIsEmpty(&value))
+                    return RADIX_OUT_OF_MEMORY;
+            }
         }
 
-        // Move to "parent-child" or "parent-parent-child"
-        while (true) {
-            Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+        // Go to the first child
+        size_t childAddress = node.childSmaller != 0 ? node.childSmaller : node.childGreater;
 
-            // "no parent"
-            if (!parentNode)
-                return result;
+        if (childAddress == 0) {
+            // Go back to the first parent with the unvisited greater child
+            while (nodeAddress != headAddress) {
+                if (steps-- == 0)
+                    return RADIX_INVALID_ARGUMENT;
 
-            if (parentNode->childSmaller != 0 && parentNode->childSmaller != (unsigned char*)node - radix->memory) {
-                node = (Node *) (radix->memory + parentNode->childSmaller);
+                size_t parentAddress = node.parent;
 
-                break;
+                keyBits -= node.keyBits;
+
+                if (!imageNode(layout, image, imageSize, parentAddress, &node))
+                    return RADIX_INVALID_ARGUMENT;
+
+                if (node.childSmaller == nodeAddress && node.childGreater != 0) {
+                    childAddress = node.childGreater;
+                    break;
+                }
+
+                nodeAddress = parentAddress;
             }
 
-            node = parentNode;
+            if (childAddress == 0)
+                return RADIX_SUCCESS;
         }
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+        nodeAddress = childAddress;
 
-        // If matched node has item not nullable - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+        if (!imageNode(layout, image, imageSize, nodeAddress, &node) || keyBits + node.keyBits < keyBits)
+            return RADIX_INVALID_ARGUMENT;
 
-            return result;
-        }
+        if (target)
+            bitCopy(image + node.keyFore, node.keyForeOffset, scratch, keyBits, node.keyBits);
+
+        keyBits += node.keyBits;
     }
 }
 
-RadixIterator radixPrevInverseNullable(RadixIterator *iterator)
+RadixError radixImport(Radix *radix, unsigned char *input, size_t inputSize)
 {
-    Radix *radix = iterator->radix;
+    if (inputSize < RADIX_IMAGE_HEADER_SIZE || input[0] != 'R' || input[1] != 'D' || input[2] != 'X' || input[3] != 'I')
+        return RADIX_INVALID_ARGUMENT;
 
-    Meta *meta = (Meta *)radix->memory;
+    if (imageRead(input + 4, 2) != RADIX_IMAGE_VERSION || imageRead(input + 6, 2) != RADIX_IMAGE_HEADER_SIZE)
+        return RADIX_INVALID_ARGUMENT;
 
-    RadixIterator result = {0};
+    uint64_t blockSize = imageRead(input + 36, 4);
+    uint64_t usage = imageRead(input + 40, 8);
 
-    result.radix = radix;
+    if (blockSize == 0 || usage > inputSize)
+        return RADIX_INVALID_ARGUMENT;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    size_t blocks = (size_t) ((usage + blockSize - 1) / blockSize);
 
-    // if node is null - start iteration by finding the greatest first of all nodes
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+    if (blocks > (inputSize - RADIX_IMAGE_HEADER_SIZE) / sizeof(uint32_t) || usage > inputSize - RADIX_IMAGE_HEADER_SIZE - blocks * sizeof(uint32_t))
+        return RADIX_INVALID_ARGUMENT;
 
-        // Retrieve head-node - this is greatest first of all nodes
-        node = (Node *) (radix->memory + sizeof(Meta));
+    unsigned char *checksums = input + RADIX_IMAGE_HEADER_SIZE;
+    unsigned char *image = checksums + blocks * sizeof(uint32_t);
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    // Header checksum covers the block checksums too
+    if (crc32c(crc32c(0, input, 52), checksums, blocks * sizeof(uint32_t)) != imageRead(input + 52, sizeof(uint32_t)))
+        return RADIX_INVALID_ARGUMENT;
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    // All blocks are verified before anything is copied, so the damaged image leaves the structure untouched
+    for (size_t block = 0; block < blocks; block++) {
+        size_t blockFore = block * blockSize;
+        size_t blockBytes = usage - blockFore < blockSize ? usage - blockFore : blockSize;
 
-            return result;
-        }
+        if (crc32c(0, image + blockFore, blockBytes) != imageRead(checksums + block * sizeof(uint32_t), sizeof(uint32_t)))
+            return RADIX_INVALID_ARGUMENT;
     }
 
-    // Move to smaller (longer < shorter)
-    // Priority:
-    // 1. child
-    // 2. parent-child
-    // 3. parent-parent-child
-    //   no parent - return empty iterator
-    while (true) {
-        // move to "child"
-        if (node->childGreater != 0 || node->childSmaller != 0) {
-            node = (Node *) (radix->memory + (node->childGreater != 0 ? node->childGreater : node->childSmaller));
+    unsigned char layoutBytes[RADIX_IMAGE_LAYOUT_SIZE];
 
-            Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    // Frozen image has no node size
+    bool frozenImage = imageRead(input + RADIX_IMAGE_LAYOUT_FORE + 6, 2) == 0;
 
-            // If matched node has item nullable - this is the object you are looking for
-            if (item) {
-                result.node = (unsigned char *)node - radix->memory;
-                result.data = (unsigned char*)item + sizeof(Item);
-                result.dataSize = item->size;
+    imageLayout(layoutBytes, frozenImage);
 
-                return result;
-            }
+    bool sameLayout = true;
 
-            continue;
-        }
+    for (size_t i = 0; i < RADIX_IMAGE_LAYOUT_SIZE; i++) {
+        sameLayout = sameLayout && layoutBytes[i] == input[RADIX_IMAGE_LAYOUT_FORE + i];
+    }
 
-        // Move to "parent-child" or "parent-parent-child"
-        while (true) {
-            Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    // Image of the same layout is copied as is (all addresses are relative)
+    if (sameLayout) {
+        if (usage < sizeof(Meta))
+            return RADIX_INVALID_ARGUMENT;
 
-            // "no parent"
-            if (!parentNode)
-                return result;
+        if (usage > radix->memorySize)
+            return RADIX_OUT_OF_MEMORY;
 
-            if (parentNode->childSmaller != 0 && parentNode->childSmaller != (unsigned char*)node - radix->memory) {
-                node = (Node *) (radix->memory + parentNode->childSmaller);
+        byteCopy(radix->memory, image, (size_t)usage);
 
-                break;
-            }
+        Meta *meta = (Meta *)radix->memory;
 
-            node = parentNode;
-        }
+        if (meta->cache != 0 && meta->cacheEnd > radix->memorySize)
+            meta->cacheEnd = radix->memorySize;
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+        return RADIX_SUCCESS;
+    }
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    // Frozen records are not translated, frozen images of the other layouts are rejected
+    if (frozenImage)
+        return RADIX_INVALID_ARGUMENT;
+
+    // Image of the other layout is translated
+
+    unsigned char *layoutInput = input + RADIX_IMAGE_LAYOUT_FORE;
+
+    ImageLayout layout = {
+        .bigEndian = layoutInput[0] != 0,
+        .bitfieldsFromTop = layoutInput[1] != 0,
+        .offsetSize = layoutInput[2],
+        .sizeSize = layoutInput[3],
+        .bitfieldByte = layoutInput[5],
+        .nodeSize = (size_t)imageRead(layoutInput + 6, 2),
+        .itemSize = (size_t)imageRead(layoutInput + 8, 2),
+        .metaSize = (size_t)imageRead(layoutInput + 10, 2),
+        .childSmaller = (size_t)imageRead(layoutInput + 12, 2),
+        .childGreater = (size_t)imageRead(layoutInput + 14, 2),
+        .keyFore = (size_t)imageRead(layoutInput + 16, 2),
+        .keyRear = (size_t)imageRead(layoutInput + 18, 2),
+        .item = (size_t)imageRead(layoutInput + 20, 2),
+        .parent = (size_t)imageRead(layoutInput + 22, 2),
+        .itemSizeField = (size_t)imageRead(layoutInput + 24, 2),
+        .itemPrefix = (size_t)imageRead(input + 48, 2),
+        .itemExpiry = imageRead(input + 50, 2) != 0,
+    };
 
-            return result;
-        }
-    }
-}
+    if (layout.offsetSize < 2 || layout.offsetSize > sizeof(uint64_t) || layout.sizeSize == 0 || layout.sizeSize > sizeof(uint64_t) || layout.nodeSize == 0 || layout.bitfieldByte >= layout.nodeSize || (layout.itemExpiry && layout.itemPrefix < sizeof(uint64_t)))
+        return RADIX_INVALID_ARGUMENT;
 
-RadixIterator radixNextInverse(RadixIterator *iterator)
-{
-    Radix *radix = iterator->radix;
+    // Values are expired at the time of the import (the clock is read once)
+    uint64_t time = clockTime(radix);
 
-    Meta *meta = (Meta *)radix->memory;
+    // Measure the scratch memory (the longest key and compressed data) at the end of the structure memory
+    // and count the values which keep expiring
+    size_t keyMemory = 0;
+    size_t storageMemory = 0;
+    size_t expiring = 0;
 
-    RadixIterator result = {0};
+    RadixError error = imageReplay(NULL, &layout, image, (size_t)usage, time, NULL, &keyMemory, &storageMemory, &expiring);
 
-    result.radix = radix;
+    if (error != RADIX_SUCCESS)
+        return error;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    // Scratch memory and the expiry heap must fit beside the meta and the head-node (nothing is cleared before)
+    size_t freeMemory = radix->memorySize > sizeof(Meta) + sizeof(Node) ? radix->memorySize - sizeof(Meta) - sizeof(Node) : 0;
 
-    // If node is null, this means we should start with the smallest leaf of all nodes
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+    if (keyMemory + storageMemory > freeMemory || expiring > (freeMemory - keyMemory - storageMemory) / sizeof(ExpiryEntry))
+        return RADIX_OUT_OF_MEMORY;
 
-        // Retrieve head-node
-        node = (Node *) (radix->memory + sizeof(Meta));
+    // Expiring values get the expiry heap with a slot for each of them
+    RadixOptions options = {
+        .expirySlots = expiring,
+        .clock = radix->clock,
+        .clockContext = radix->clockContext,
+    };
 
-        // Move to the smallest leaf-node of given node
-        while (node->childGreater != 0 || node->childSmaller != 0) {
-            node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
-        }
+    radixClearOptions(radix, &options);
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    Radix target = *radix;
 
-        // If matched node has item not nullable - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    target.memorySize -= keyMemory + storageMemory;
 
-            return result;
-        }
-    }
+    return imageReplay(&target, &layout, image, (size_t)usage, time, radix->memory + target.memorySize, &keyMemory, &storageMemory, &expiring);
+}
 
-    // Move to greater (longer < shorter)
-    // Priority:
-    // 1: parent-child-child (leaf child)
-    // 2: parent-child
-    // 3: parent
-    //   no parent - return empty iterator
-    while (true) {
-        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+typedef struct Stream {
+    RadixStreamWrite write;
+    RadixStreamRead read;
+    void *context;
 
-        // "no parent"
-        if (!parentNode)
-            return result;
+    unsigned char *block;
+    size_t blockSize;
 
-        // Move
-        if (parentNode->childGreater != 0 && parentNode->childGreater != (unsigned char*)node - radix->memory) {
-            node = (Node *) (radix->memory + parentNode->childGreater);
+    // Export fills the block up to the position, import consumes it from the position up to the end
+    size_t position;
+    size_t end;
+    bool finished;
 
-            // Move to "parent-child-child" or "parent-child"
-            while (node->childGreater != 0 || node->childSmaller != 0) {
-                node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
-            }
-        } else {
-            // Move to "parent"
-            node = parentNode;
-        }
+    uint32_t crc;
+} Stream;
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+static bool streamFlush(Stream *stream)
+{
+    if (stream->position == 0)
+        return true;
 
-        // If matched node has item (not nullable) - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    stream->crc = crc32c(stream->crc, stream->block, stream->position);
 
-            return result;
-        }
-    }
+    size_t size = stream->position;
+
+    stream->position = 0;
+
+    return stream->write(stream->context, stream->block, size);
 }
 
-RadixIterator radixNextInverseNullable(RadixIterator *iterator)
+static bool streamPut(Stream *stream, const unsigned char *data, size_t size)
 {
-    Radix *radix = iterator->radix;
+    if (size > stream->blockSize - stream->position) {
+        if (!streamFlush(stream))
+            return false;
 
-    Meta *meta = (Meta *)radix->memory;
+        // Data not fitting into the block is written directly (without copying)
+        if (size >= stream->blockSize) {
+            stream->crc = crc32c(stream->crc, data, size);
 
-    RadixIterator result = {0};
+            return stream->write(stream->context, (unsigned char *)data, size);
+        }
+    }
 
-    result.radix = radix;
+    byteCopy(stream->block + stream->position, data, size);
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    stream->position += size;
 
-    // If node is null, this means we should start with the smallest leaf of all nodes
-    if (!node) {
-        // If the structure has not been managed before, you can't start from head
-        if (meta->lastNode == 0)
-            return result;
+    return true;
+}
 
-        // Retrieve head-node
-        node = (Node *) (radix->memory + sizeof(Meta));
+static bool streamPutNumber(Stream *stream, uint64_t value)
+{
+    unsigned char bytes[RADIX_STREAM_NUMBER_SIZE];
+    size_t size = 0;
 
-        // Move to the smallest leaf-node of given node
-        while (node->childGreater != 0 || node->childSmaller != 0) {
-            node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
-        }
+    do {
+        bytes[size] = (value & 0x7f) | (value > 0x7f ? 0x80 : 0);
+        value >>= 7;
+        size++;
+    } while (value != 0);
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    return streamPut(stream, bytes, size);
+}
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+static inline size_t streamNodeKeyBits(Node *node)
+{
+    return CHAR_BIT * (node->keyRear - node->keyFore) + node->keyRearOffset - node->keyForeOffset;
+}
 
-            return result;
-        }
-    }
+// Appends the node key to the key, returns false if the key memory is too small
+static inline bool streamNodeKey(Radix *radix, Node *node, unsigned char *key, size_t *keyBits, size_t keyMemorySize)
+{
+    size_t nodeKeyBits = streamNodeKeyBits(node);
 
-    // Move to greater (longer < shorter)
-    // Priority:
-    // 1: parent-child-child (leaf child)
-    // 2: parent-child
-    // 3: parent
-    //   no parent - return empty iterator
-    while (true) {
-        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    if (*keyBits + nodeKeyBits > keyMemorySize * CHAR_BIT)
+        return false;
 
-        // "no parent"
-        if (!parentNode)
-            return result;
+    bitCopy(radix->memory + node->keyFore, node->keyForeOffset, key, *keyBits, nodeKeyBits);
 
-        // Move
-        if (parentNode->childGreater != 0 && parentNode->childGreater != (unsigned char*)node - radix->memory) {
-            node = (Node *) (radix->memory + parentNode->childGreater);
+    *keyBits += nodeKeyBits;
 
-            // Move to "parent-child-child" or "parent-child"
-            while (node->childGreater != 0 || node->childSmaller != 0) {
-                node = (Node *) (radix->memory + (node->childSmaller != 0 ? node->childSmaller : node->childGreater));
-            }
-        } else {
-            // Move to "parent"
-            node = parentNode;
-        }
+    return true;
+}
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+static bool streamPutKey(Stream *stream, unsigned char *key, size_t keyBits, size_t sharedBits)
+{
+    size_t keySize = (keyBits + CHAR_BIT - 1) / CHAR_BIT;
+    size_t sharedSize = sharedBits / CHAR_BIT;
 
-        // If matched node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    // Bits after the key are left by the previous keys
+    if (keyBits % CHAR_BIT != 0)
+        key[keySize - 1] &= (unsigned char)(0xff << (CHAR_BIT - keyBits % CHAR_BIT));
 
-            return result;
-        }
-    }
+    // Record is the key size (0 ends the stream), size of the key part shared with the previous key,
+    // the rest of the key and the data with its size
+    return streamPutNumber(stream, (uint64_t)keyBits + 1) && streamPutNumber(stream, sharedSize) && streamPut(stream, key + sharedSize, keySize - sharedSize);
 }
 
-RadixIterator radixEarlier(RadixIterator *iterator)
+static RadixError streamPutValue(Stream *stream, Radix *radix, Item *item, unsigned char *key, size_t keyBits, size_t sharedBits)
 {
-    Radix *radix = iterator->radix;
+    if (!streamPutKey(stream, key, keyBits, sharedBits) || !streamPutNumber(stream, itemSize(item)))
+        return RADIX_INVALID_ARGUMENT;
 
-    Meta *meta = (Meta *)radix->memory;
-
-    RadixIterator result = {0};
+    if (itemKind(item) != ITEM_COMPRESSED)
+        return streamPut(stream, itemData(radix, item), itemSize(item)) ? RADIX_SUCCESS : RADIX_INVALID_ARGUMENT;
 
-    result.radix = radix;
+    // Compressed data is decompressed into the emptied block
+    if (itemSize(item) > stream->blockSize)
+        return RADIX_OUT_OF_MEMORY;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    if (!streamFlush(stream))
+        return RADIX_INVALID_ARGUMENT;
 
-    // if node is null - start iteration by finding the latest node
-    if (!node) {
-        node = meta->lastNode != 0 ? (Node *) (radix->memory + meta->lastNode) : NULL;
+    ItemCompressed *compressed = (ItemCompressed *) itemStorage(item);
 
-        if (!node)
-            return result;
+    if (!decompress((unsigned char *)compressed + sizeof(ItemCompressed), compressed->size, stream->block, itemSize(item)))
+        return RADIX_INVALID_ARGUMENT;
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    stream->position = itemSize(item);
 
-        // If node has item (not nullable) - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    return RADIX_SUCCESS;
+}
 
-            return result;
-        }
-    }
+RadixError radixStreamExport(Radix *radix, RadixStreamWrite write, void *context, unsigned char *buffer, size_t bufferSize)
+{
+    Meta *meta = (Meta *)radix->memory;
 
-    // Move to earlier node than given
-    while (true) {
-        node = node->lastNode != 0 ? (Node *) (radix->memory + node->lastNode) : NULL;
+    uint64_t time = itemTime(radix);
 
-        if (!node)
-            return result;
+    // First half of the buffer holds the current key, the other one is the block of the stream
+    size_t keyMemorySize = bufferSize / 2;
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+    unsigned char *key = buffer;
 
-        // If node has item (not nullable) - this is the object you are looking for
-        if (item && item->size > 0) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    Stream stream = {
+        .write = write,
+        .context = context,
+        .block = buffer + keyMemorySize,
+        .blockSize = bufferSize - keyMemorySize,
+    };
 
-            return result;
-        }
-    }
-}
+    if (keyMemorySize == 0)
+        return RADIX_OUT_OF_MEMORY;
 
-RadixIterator radixEarlierNullable(RadixIterator *iterator)
-{
-    Radix *radix = iterator->radix;
+    const unsigned char header[RADIX_STREAM_HEADER_SIZE] = {'R', 'D', 'X', 'S', RADIX_STREAM_VERSION};
 
-    Meta *meta = (Meta *)radix->memory;
+    if (!streamPut(&stream, header, RADIX_STREAM_HEADER_SIZE))
+        return RADIX_INVALID_ARGUMENT;
 
-    RadixIterator result = {0};
+    // Frozen values are visited in the key order of their records, the key is copied for every value
+    // and its part shared with the previous key is the key of their deepest common record
+    if (meta->frozen) {
+        RadixIterator iterator = radixIterator(radix);
 
-    result.radix = radix;
+        size_t previous = 0;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+        for (iterator = frozenNext(&iterator); !radixIteratorIsEmpty(&iterator); iterator = frozenNext(&iterator)) {
+            size_t keyBits = frozenKeyBits(&iterator);
 
-    // if node is null - start iteration by finding the latest node
-    if (!node) {
-        node = meta->lastNode != 0 ? (Node *) (radix->memory + meta->lastNode) : NULL;
+            if (keyBits > keyMemorySize * CHAR_BIT)
+                return RADIX_OUT_OF_MEMORY;
 
-        if (!node)
-            return result;
+            frozenKeyCopy(&iterator, key, keyBits);
 
-        Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+            size_t sharedBits = previous != 0 ? frozenSharedBits(radix, previous, iterator.node) : 0;
 
-        // If node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+            if (!streamPutKey(&stream, key, keyBits, sharedBits) || !streamPutNumber(&stream, iterator.dataSize) || !streamPut(&stream, iterator.data, iterator.dataSize))
+                return RADIX_INVALID_ARGUMENT;
 
-            return result;
+            previous = iterator.node;
         }
     }
 
-    // Move to earlier node than given
-    while (true) {
-        node = node->lastNode != 0 ? (Node *) (radix->memory + node->lastNode) : NULL;
+    // Visit nodes in the key order (subtrees without visible values are skipped),
+    // the key is extended by the nodes on the way down and shortened on the way back
+    Node *head = (Node *) (radix->memory + sizeof(Meta));
+    Node *node = meta->lastNode != 0 ? head : NULL;
 
-        // If node has no earlier node - return empty iterator
-        if (!node)
-            return result;
+    size_t keyBits = 0;
+
+    // Bits shared by the current key and the last written key
+    size_t sharedBits = 0;
 
+    while (node) {
         Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
 
-        // If node has item (nullable) - this is the object you are looking for
-        if (item) {
-            result.node = (unsigned char *)node - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+        if (item && itemVisible(radix, item, time)) {
+            RadixError error = streamPutValue(&stream, radix, item, key, keyBits, sharedBits);
 
-            return result;
+            if (error != RADIX_SUCCESS)
+                return error;
+
+            sharedBits = keyBits;
+        }
+
+        // Go to the first child
+        size_t childAddress = liveChild(radix, node->childSmaller) != 0 ? node->childSmaller : liveChild(radix, node->childGreater);
+
+        if (childAddress != 0) {
+            node = (Node *) (radix->memory + childAddress);
+
+            if (!streamNodeKey(radix, node, key, &keyBits, keyMemorySize))
+                return RADIX_OUT_OF_MEMORY;
+
+            continue;
         }
-    }
-}
 
-RadixValue radixIteratorToValue(RadixIterator *iterator)
-{
-    Radix *radix = iterator->radix;
+        // Go back to the first parent with the unvisited greater child
+        while (node != head) {
+            size_t nodeAddress = (unsigned char *)node - radix->memory;
 
-    RadixValue result = {0};
+            Node *parent = (Node *) (radix->memory + node->parent);
 
-    result.radix = radix;
+            keyBits -= streamNodeKeyBits(node);
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+            if (sharedBits > keyBits)
+                sharedBits = keyBits;
 
-    if (!node)
-        return result;
+            if (parent->childSmaller == nodeAddress && liveChild(radix, parent->childGreater) != 0) {
+                node = (Node *) (radix->memory + parent->childGreater);
 
-    Item *item = node->item != 0 ? (Item *) (radix->memory + node->item) : NULL;
+                if (!streamNodeKey(radix, node, key, &keyBits, keyMemorySize))
+                    return RADIX_OUT_OF_MEMORY;
 
-    if (!item)
-        return result;
+                break;
+            }
 
-    result.item = (unsigned char*)item - radix->memory;
-    result.data = (unsigned char*)item + sizeof(Item);
-    result.dataSize = item->size;
+            node = parent;
+        }
 
-    return result;
-}
+        if (node == head)
+            node = NULL;
+    }
 
-RadixCheckpoint radixIteratorToCheckpoint(RadixIterator *iterator)
-{
-    return (RadixCheckpoint) { .state = iterator->node };
-}
+    if (!streamPutNumber(&stream, 0) || !streamFlush(&stream))
+        return RADIX_INVALID_ARGUMENT;
 
-bool radixIteratorIsEmpty(RadixIterator *iterator)
-{
-    return iterator->node == 0;
+    // Checksum of all the previous bytes ends the stream
+    unsigned char checksum[sizeof(uint32_t)];
+
+    imageWrite(checksum, stream.crc, sizeof(uint32_t));
+
+    return write(context, checksum, sizeof(uint32_t)) ? RADIX_SUCCESS : RADIX_INVALID_ARGUMENT;
 }
 
-RadixValue radixValuePrevious(RadixValue *iterator)
+// Makes at least size bytes available in the block (if the stream has them)
+static bool streamFill(Stream *stream, size_t size)
 {
-    Radix *radix = iterator->radix;
-
-    RadixValue result = {0};
+    if (stream->end - stream->position >= size)
+        return true;
 
-    result.radix = radix;
+    // Move the rest of the block to its beginning and read as much as fits after it
+    byteCopy(stream->block, stream->block + stream->position, stream->end - stream->position);
 
-    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+    stream->end -= stream->position;
+    stream->position = 0;
 
-    while (item) {
-        item = item->previous != 0 ? (Item *) (radix->memory + item->previous) : NULL;
+    while (stream->end < size && !stream->finished) {
+        size_t read = stream->read(stream->context, stream->block + stream->end, stream->blockSize - stream->end);
 
-        if (item && item->size > 0) {
-            result.item = (unsigned char *)item - radix->memory;
-            result.data = (unsigned char *)item + sizeof(Item);
-            result.dataSize = item->size;
+        if (read == 0)
+            stream->finished = true;
 
-            return result;
-        }
+        stream->end += read;
     }
 
-    return result;
+    return stream->end >= size;
 }
 
-RadixValue radixValuePreviousNullable(RadixValue *iterator)
+static unsigned char *streamTake(Stream *stream, size_t size)
 {
-    Radix *radix = iterator->radix;
+    if (size > stream->blockSize || !streamFill(stream, size))
+        return NULL;
 
-    RadixValue result = {0};
+    unsigned char *data = stream->block + stream->position;
 
-    result.radix = radix;
+    stream->crc = crc32c(stream->crc, data, size);
+    stream->position += size;
 
-    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+    return data;
+}
 
-    while (item) {
-        item = item->previous != 0 ? (Item *) (radix->memory + item->previous) : NULL;
+static bool streamTakeNumber(Stream *stream, uint64_t *value)
+{
+    // Number may be shorter than its largest size at the end of the stream
+    streamFill(stream, RADIX_STREAM_NUMBER_SIZE);
 
-        if (item) {
-            result.item = (unsigned char *)item - radix->memory;
-            result.data = (unsigned char *)item + sizeof(Item);
-            result.dataSize = item->size;
+    *value = 0;
 
-            return result;
-        }
+    for (size_t i = 0; i < RADIX_STREAM_NUMBER_SIZE && stream->position + i < stream->end; i++) {
+        unsigned char byte = stream->block[stream->position + i];
+
+        *value |= (uint64_t)(byte & 0x7f) << (7 * i);
+
+        if ((byte & 0x80) == 0)
+            return streamTake(stream, i + 1) != NULL;
     }
 
-    return result;
+    return false;
 }
 
-RadixValue radixValueEarlier(RadixValue *iterator)
+RadixError radixStreamImport(Radix *radix, RadixStreamRead read, void *context, unsigned char *buffer, size_t bufferSize)
 {
-    Radix *radix = iterator->radix;
+    // First half of the buffer holds the current key, the other one is the block of the stream
+    size_t keyMemorySize = bufferSize / 2;
+
+    unsigned char *key = buffer;
+
+    Stream stream = {
+        .read = read,
+        .context = context,
+        .block = buffer + keyMemorySize,
+        .blockSize = bufferSize - keyMemorySize,
+    };
+
+    if (keyMemorySize == 0 || stream.blockSize < RADIX_STREAM_NUMBER_SIZE)
+        return RADIX_OUT_OF_MEMORY;
+
+    unsigned char *header = streamTake(&stream, RADIX_STREAM_HEADER_SIZE);
+
+    if (!header || header[0] != 'R' || header[1] != 'D' || header[2] != 'X' || header[3] != 'S' || header[4] != RADIX_STREAM_VERSION)
+        return RADIX_INVALID_ARGUMENT;
 
     Meta *meta = (Meta *)radix->memory;
 
-    RadixValue result = {0};
+    RadixCheckpoint checkpoint = radixCheckpoint(radix);
 
-    result.radix = radix;
+    RadixError error = RADIX_SUCCESS;
 
-    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+    // Key is kept by the import itself (only its changed part is read)
+    RadixFinger finger = radixFinger(radix, NULL, 0);
 
-    // if item is null - start iteration by finding the latest value
-    if (!item) {
-        item = meta->lastItem != 0 ? (Item *) (radix->memory + meta->lastItem) : NULL;
+    size_t previousKeyBits = 0;
 
-        if (item && item->size > 0) {
-            result.item = (unsigned char *)item - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+    while (true) {
+        uint64_t keyCode;
+        uint64_t sharedSize;
+        uint64_t dataSize;
 
-            return result;
+        if (!streamTakeNumber(&stream, &keyCode)) {
+            error = RADIX_INVALID_ARGUMENT;
+            break;
         }
-    }
 
-    // Move to earlier item than given
-    while (item) {
-        item = item->lastItem != 0 ? (Item *) (radix->memory + item->lastItem) : NULL;
+        if (keyCode == 0)
+            break;
 
-        if (item && item->size > 0) {
-            result.item = (unsigned char *)item - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+        if (keyCode - 1 > (uint64_t)keyMemorySize * CHAR_BIT) {
+            error = RADIX_OUT_OF_MEMORY;
+            break;
+        }
 
-            return result;
+        size_t keyBits = (size_t)(keyCode - 1);
+        size_t keySize = (keyBits + CHAR_BIT - 1) / CHAR_BIT;
+
+        if (!streamTakeNumber(&stream, &sharedSize) || sharedSize > previousKeyBits / CHAR_BIT || sharedSize > keySize) {
+            error = RADIX_INVALID_ARGUMENT;
+            break;
         }
-    }
 
-    return result;
-}
+        // Taken bytes are valid until the block is filled again
+        unsigned char *keyRest = streamTake(&stream, keySize - (size_t)sharedSize);
 
-RadixValue radixValueEarlierNullable(RadixValue *iterator)
-{
-    Radix *radix = iterator->radix;
+        if (!keyRest) {
+            error = RADIX_INVALID_ARGUMENT;
+            break;
+        }
 
-    Meta *meta = (Meta *)radix->memory;
+        byteCopy(key + sharedSize, keyRest, keySize - (size_t)sharedSize);
 
-    RadixValue result = {0};
+        if (!streamTakeNumber(&stream, &dataSize)) {
+            error = RADIX_INVALID_ARGUMENT;
+            break;
+        }
 
-    result.radix = radix;
+        if (dataSize > stream.blockSize) {
+            error = RADIX_OUT_OF_MEMORY;
+            break;
+        }
 
-    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+        // Data is inserted right from the block
+        unsigned char *data = streamTake(&stream, (size_t)dataSize);
 
-    // if item is null - start iteration by finding the latest value
-    if (!item) {
-        item = meta->lastItem != 0 ? (Item *) (radix->memory + meta->lastItem) : NULL;
+        if (!data) {
+            error = RADIX_INVALID_ARGUMENT;
+            break;
+        }
 
-        if (item) {
-            result.item = (unsigned char *)item - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+        // Sorted keys share their path with the previous key ..insert from their deepest common ancestor
+        RadixValue value;
 
-            return result;
+        if (radixIteratorIsEmpty(&finger.iterator)) {
+            value = radixInsert(&finger.iterator, key, keyBits, data, (size_t)dataSize);
+        } else {
+            size_t nodeKeyBits;
+
+            Node *node = fingerAncestorShared(radix, &finger, (size_t)sharedSize * CHAR_BIT, &nodeKeyBits);
+
+            value = insert(radix, node, key, nodeKeyBits, keyBits, ITEM_INLINE, data, (size_t)dataSize, (size_t)dataSize, 0);
+        }
+
+        // Cache mode deletes removed keys physically ..their empty value means success
+        if (radixValueIsEmpty(&value) && (meta->cache == 0 || dataSize != 0)) {
+            error = RADIX_OUT_OF_MEMORY;
+            break;
         }
+
+        previousKeyBits = keyBits;
+
+        // Cache mode releases nodes (removals, evictions) ..the next key is inserted from the head-node
+        if (meta->cache != 0)
+            continue;
+
+        Item *item = (Item *) (radix->memory + value.item);
+
+        finger.iterator.node = item->node;
+        finger.key = key;
+        finger.keyBits = keyBits;
     }
 
-    // Move to earlier item than given
-    while (item) {
-        item = item->lastItem != 0 ? (Item *) (radix->memory + item->lastItem) : NULL;
+    // Checksum of all the previous bytes ends the stream
+    if (error == RADIX_SUCCESS) {
+        uint32_t crc = stream.crc;
 
-        if (item) {
-            result.item = (unsigned char *)item - radix->memory;
-            result.data = (unsigned char*)item + sizeof(Item);
-            result.dataSize = item->size;
+        unsigned char *checksum = streamTake(&stream, sizeof(uint32_t));
 
-            return result;
-        }
+        if (!checksum || imageRead(checksum, sizeof(uint32_t)) != crc)
+            error = RADIX_INVALID_ARGUMENT;
     }
 
-    return result;
+    // If stream could not be imported as a whole ..restore the state before the import
+    if (error != RADIX_SUCCESS)
+        radixCheckpointRestore(radix, &checkpoint);
+
+    return error;
 }
 
-RadixIterator radixValueToIterator(RadixValue *iterator)
+typedef enum DeltaRecord {
+    DELTA_END,
+    DELTA_RANGE,
+    DELTA_NODE,
+    DELTA_META,
+} DeltaRecord;
+
+// Returns the end of the head-node and the tables of options (they are updated in place)
+static size_t deltaTablesEnd(Meta *meta)
 {
-    Radix *radix = iterator->radix;
+    size_t tablesEnd = sizeof(Meta) + sizeof(Node);
+
+    size_t ends[] = {
+        meta->index != 0 ? meta->index + meta->indexSlots * sizeof(IndexEntry) : 0,
+        meta->filter != 0 ? meta->filter + meta->filterBlocks * RADIX_FILTER_BLOCK_SIZE : 0,
+        meta->dedup != 0 ? meta->dedup + meta->dedupSlots * sizeof(IndexEntry) : 0,
+        meta->fragment != 0 ? meta->fragment + meta->fragmentSlots * sizeof(IndexEntry) : 0,
+        meta->time != 0 ? meta->time + meta->timeSlots * sizeof(TimeEntry) : 0,
+        meta->expiry != 0 ? meta->expiry + meta->expirySlots * sizeof(ExpiryEntry) : 0,
+    };
 
-    RadixIterator result = {0};
+    for (size_t i = 0; i < sizeof(ends) / sizeof(ends[0]); i++) {
+        if (ends[i] > tablesEnd)
+            tablesEnd = ends[i];
+    }
 
-    result.radix = radix;
+    return tablesEnd;
+}
 
-    Item *item = iterator->item != 0 ? (Item *) (radix->memory + iterator->item) : NULL;
+static bool deltaPutRecord(Stream *stream, DeltaRecord kind, size_t offset, const unsigned char *data, size_t size)
+{
+    unsigned char record[RADIX_DELTA_RECORD_SIZE];
 
-    if (!item)
-        return result;
+    record[0] = kind;
 
-    result.node = item->node;
-    result.data = iterator->data;
-    result.dataSize = iterator->dataSize;
+    imageWrite(record + 1, offset, sizeof(uint64_t));
+    imageWrite(record + 9, size, sizeof(uint64_t));
 
-    return result;
+    return streamPut(stream, record, RADIX_DELTA_RECORD_SIZE) && streamPut(stream, data, size);
 }
 
-RadixCheckpoint radixValueToCheckpoint(RadixValue *iterator)
+static inline bool deltaPutNode(Stream *stream, Radix *radix, size_t node, size_t since)
 {
-    return (RadixCheckpoint) { .state = iterator->item };
-}
+    // Nodes written after the checkpoint are part of the appended bytes
+    if (node == 0 || node >= since)
+        return true;
 
-bool radixValueIsEmpty(RadixValue *iterator)
-{
-    return iterator->item == 0;
+    return deltaPutRecord(stream, DELTA_NODE, node, radix->memory + node, sizeof(Node));
 }
 
-size_t radixKeyBits(RadixIterator *iterator)
+RadixError radixDeltaSince(Radix *radix, RadixCheckpoint *checkpoint, RadixStreamWrite write, void *context)
 {
-    Radix *radix = iterator->radix;
+    Meta *meta = (Meta *)radix->memory;
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    size_t since = checkpoint->state;
 
-    size_t keyBits = 0;
+    // Cache mode reuses the memory of evicted keys, so its changes are not appended (frozen structures do not change)
+    if (meta->cache != 0 || meta->frozen || since < sizeof(Meta) || since > meta->structureEnd)
+        return RADIX_INVALID_ARGUMENT;
 
-    while(node) {
-        keyBits += CHAR_BIT * (node->keyRear - node->keyFore) + node->keyRearOffset - node->keyForeOffset;
+    // Referenced data and the value log are not part of the structure memory
+    for (size_t itemAddress = meta->lastItem; itemAddress >= since && itemAddress != 0;) {
+        Item *item = (Item *) (radix->memory + itemAddress);
 
-        node = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+        if (itemKind(item) == ITEM_REFERENCE || itemKind(item) == ITEM_LOG)
+            return RADIX_INVALID_ARGUMENT;
+
+        itemAddress = item->lastItem;
     }
 
-    return keyBits;
-}
+    unsigned char block[RADIX_DELTA_BLOCK_SIZE];
 
-RadixError radixKeyCopy(RadixIterator *iterator, unsigned char *outputKey, size_t keyBits)
-{
-    Radix *radix = iterator->radix;
+    Stream stream = {
+        .write = write,
+        .context = context,
+        .block = block,
+        .blockSize = RADIX_DELTA_BLOCK_SIZE,
+    };
 
-    Node *node = iterator->node != 0 ? (Node *) (radix->memory + iterator->node) : NULL;
+    // Header has the layout of the image (bytes are applied as they are)
+    unsigned char header[RADIX_DELTA_HEADER_SIZE] = {'R', 'D', 'X', 'D'};
 
-    while (node) {
-        size_t nodeKeyBits = CHAR_BIT * (node->keyRear - node->keyFore) + node->keyRearOffset - node->keyForeOffset;
+    imageWrite(header + 4, RADIX_DELTA_VERSION, 2);
+    imageLayout(header + 6, false);
+    imageWrite(header + 34, since, sizeof(uint64_t));
+    imageWrite(header + 42, meta->structureEnd, sizeof(uint64_t));
 
-        // If its out of memory.. copy only suffix of nodeKey and return error
-        if (keyBits < nodeKeyBits) {
-            size_t nodeKeySuffixOffset = nodeKeyBits + node->keyForeOffset - keyBits;
+    if (!streamPut(&stream, header, RADIX_DELTA_HEADER_SIZE))
+        return RADIX_INVALID_ARGUMENT;
 
-            bitCopy(radix->memory + node->keyFore, nodeKeySuffixOffset, outputKey, keyBits, keyBits);
+    // Bytes appended since the checkpoint
+    if (!deltaPutRecord(&stream, DELTA_RANGE, since, radix->memory + since, meta->structureEnd - since))
+        return RADIX_INVALID_ARGUMENT;
 
-            return RADIX_OUT_OF_MEMORY;
-        }
+    // Head-node and the tables of options written before the checkpoint
+    size_t tablesEnd = deltaTablesEnd(meta);
 
-        keyBits -= nodeKeyBits;
+    if (tablesEnd > since)
+        tablesEnd = since;
 
-        bitCopy(radix->memory + node->keyFore, node->keyForeOffset, outputKey, keyBits, nodeKeyBits);
+    if (tablesEnd > sizeof(Meta) && !deltaPutRecord(&stream, DELTA_RANGE, sizeof(Meta), radix->memory + sizeof(Meta), tablesEnd - sizeof(Meta)))
+        return RADIX_INVALID_ARGUMENT;
 
-        node = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+    // Older owners of new items (once per owner - by its first item written after the checkpoint)
+    for (size_t itemAddress = meta->lastItem; itemAddress >= since && itemAddress != 0;) {
+        Item *item = (Item *) (radix->memory + itemAddress);
+
+        if (item->previous < since && !deltaPutNode(&stream, radix, item->node, since))
+            return RADIX_INVALID_ARGUMENT;
+
+        itemAddress = item->lastItem;
     }
 
-    return RADIX_SUCCESS;
+    // Older parents and splitted children of new nodes
+    for (size_t nodeAddress = meta->lastNode; nodeAddress >= since && nodeAddress != 0;) {
+        Node *node = (Node *) (radix->memory + nodeAddress);
+
+        if (!deltaPutNode(&stream, radix, node->parent, since) || !deltaPutNode(&stream, radix, node->childSmaller, since) || !deltaPutNode(&stream, radix, node->childGreater, since))
+            return RADIX_INVALID_ARGUMENT;
+
+        nodeAddress = node->lastNode;
+    }
+
+    if (!deltaPutRecord(&stream, DELTA_META, 0, radix->memory, sizeof(Meta)) || !deltaPutRecord(&stream, DELTA_END, 0, NULL, 0) || !streamFlush(&stream))
+        return RADIX_INVALID_ARGUMENT;
+
+    // Checksum of all the previous bytes ends the delta
+    unsigned char checksum[sizeof(uint32_t)];
+
+    imageWrite(checksum, stream.crc, sizeof(uint32_t));
+
+    return write(context, checksum, sizeof(uint32_t)) ? RADIX_SUCCESS : RADIX_INVALID_ARGUMENT;
 }
 
-RadixCheckpoint radixCheckpoint(Radix *radix)
+static bool deltaTake(Stream *stream, unsigned char *data, size_t size)
 {
-    Meta *meta = (Meta *)radix->memory;
+    while (size > 0) {
+        size_t read = stream->read(stream->context, data, size);
 
-    return (RadixCheckpoint) { .state = meta->structureEnd };
+        if (read == 0)
+            return false;
+
+        stream->crc = crc32c(stream->crc, data, read);
+
+        data += read;
+        size -= read;
+    }
+
+    return true;
 }
 
-void radixCheckpointRestore(Radix *radix, RadixCheckpoint *checkpoint)
+RadixError radixApplyDelta(Radix *radix, RadixStreamRead read, void *context)
 {
     Meta *meta = (Meta *)radix->memory;
 
-    // Restore items
-    while (meta->lastItem >= checkpoint->state) {
-        Item *item = meta->lastItem != 0 ? (Item *) (radix->memory + meta->lastItem) : NULL;
+    Stream stream = {
+        .read = read,
+        .context = context,
+    };
 
-        if (!item)
-            break;
+    unsigned char header[RADIX_DELTA_HEADER_SIZE];
+    unsigned char layout[RADIX_IMAGE_LAYOUT_SIZE];
 
-        // Restore item meta
-        meta->lastItem = item->lastItem;
+    imageLayout(layout, false);
 
-        // Restore item owner
-        Node *node = (Node *) (radix->memory + item->node); // all items ​​have an owner, so we don't need to check it
+    if (!deltaTake(&stream, header, RADIX_DELTA_HEADER_SIZE))
+        return RADIX_INVALID_ARGUMENT;
 
-        node->item = item->previous;
+    if (header[0] != 'R' || header[1] != 'D' || header[2] != 'X' || header[3] != 'D' || imageRead(header + 4, 2) != RADIX_DELTA_VERSION)
+        return RADIX_INVALID_ARGUMENT;
+
+    for (size_t i = 0; i < RADIX_IMAGE_LAYOUT_SIZE; i++) {
+        if (header[6 + i] != layout[i])
+            return RADIX_INVALID_ARGUMENT;
     }
 
-    // Restore nodes
-    while (meta->lastNode >= checkpoint->state) {
-        Node *node = meta->lastNode != 0 ? (Node *) (radix->memory + meta->lastNode) : NULL;
+    uint64_t since = imageRead(header + 34, sizeof(uint64_t));
+    uint64_t end = imageRead(header + 42, sizeof(uint64_t));
 
-        if (!node)
-            break;
+    // Delta continues the state of the structure (the one at its checkpoint)
+    if (meta->cache != 0 || meta->frozen || since != meta->structureEnd || end < since)
+        return RADIX_INVALID_ARGUMENT;
 
-        // Restore node meta
-        meta->lastNode = node->lastNode;
+    if (end > radix->memorySize)
+        return RADIX_OUT_OF_MEMORY;
 
-        // Restore node child (node is splitting node)
-        size_t splittedNodeAddress = node->childSmaller != 0 ? node->childSmaller : node->childGreater;
+    // Appended bytes are read right after the structure, patches are staged after them,
+    // so nothing is changed until the whole delta is verified
+    size_t staged = (size_t)end;
 
-        Node *splittedNode = splittedNodeAddress != 0 ? (Node *) (radix->memory + splittedNodeAddress) : NULL;
+    while (true) {
+        unsigned char record[RADIX_DELTA_RECORD_SIZE];
 
-        if (splittedNode) {
-            splittedNode->parent = node->parent;
-            splittedNode->keyFore = node->keyFore;
-            splittedNode->keyForeOffset = node->keyForeOffset;
-        }
+        if (!deltaTake(&stream, record, RADIX_DELTA_RECORD_SIZE))
+            return RADIX_INVALID_ARGUMENT;
 
-        // Restore node parent (taking into account whether a node is a splitting node)
-        Node *parentNode = node->parent != 0 ? (Node *) (radix->memory + node->parent) : NULL;
+        DeltaRecord kind = record[0];
+        uint64_t offset = imageRead(record + 1, sizeof(uint64_t));
+        uint64_t size = imageRead(record + 9, sizeof(uint64_t));
 
-        if (parentNode) {
-            bool direction = bitGet(radix->memory + node->keyFore, node->keyForeOffset);
+        if (kind == DELTA_END)
+            break;
 
-            size_t *parentNodeChildReference = direction ? &(parentNode->childGreater) : &(parentNode->childSmaller);
+        if (kind == DELTA_RANGE && offset == since && size == end - since) {
+            if (!deltaTake(&stream, radix->memory + offset, (size_t)size))
+                return RADIX_INVALID_ARGUMENT;
 
-            *parentNodeChildReference = splittedNode ? (unsigned char *)splittedNode - radix->memory : 0;
+            continue;
         }
+
+        bool valid = (kind == DELTA_RANGE && offset >= sizeof(Meta)) || (kind == DELTA_NODE && size == sizeof(Node)) || (kind == DELTA_META && offset == 0 && size == sizeof(Meta));
+
+        if (!valid || offset > since || size > since - offset)
+            return RADIX_INVALID_ARGUMENT;
+
+        if (RADIX_DELTA_RECORD_SIZE + size > radix->memorySize - staged)
+            return RADIX_OUT_OF_MEMORY;
+
+        byteCopy(radix->memory + staged, record, RADIX_DELTA_RECORD_SIZE);
+
+        if (!deltaTake(&stream, radix->memory + staged + RADIX_DELTA_RECORD_SIZE, (size_t)size))
+            return RADIX_INVALID_ARGUMENT;
+
+        staged += RADIX_DELTA_RECORD_SIZE + (size_t)size;
     }
 
-    // Restore meta structure
-    meta->structureEnd = checkpoint->state;
-}
+    // Checksum of all the previous bytes ends the delta
+    uint32_t crc = stream.crc;
 
-RadixError radixClear(Radix* radix)
-{
-    size_t neededMemory = sizeof(Meta);
+    unsigned char checksum[sizeof(uint32_t)];
 
-    if (neededMemory > radix->memorySize) return RADIX_OUT_OF_MEMORY;
+    if (!deltaTake(&stream, checksum, sizeof(uint32_t)) || imageRead(checksum, sizeof(uint32_t)) != crc)
+        return RADIX_INVALID_ARGUMENT;
 
-    Meta *meta = (Meta *)radix->memory;
+    // Apply patches
+    for (size_t position = (size_t)end; position < staged;) {
+        size_t offset = (size_t)imageRead(radix->memory + position + 1, sizeof(uint64_t));
+        size_t size = (size_t)imageRead(radix->memory + position + 9, sizeof(uint64_t));
 
-    meta->lastNode = 0;
-    meta->lastItem = 0;
-    meta->structureEnd = neededMemory;
+        byteCopy(radix->memory + offset, radix->memory + position + RADIX_DELTA_RECORD_SIZE, size);
 
-    return RADIX_SUCCESS;
-}
+        position += RADIX_DELTA_RECORD_SIZE + size;
+    }
 
-size_t radixMemoryUsage(Radix *radix)
-{
-    Meta *meta = (Meta *)radix->memory;
+    // Patched nodes are up to date, the visible values flags of their older ancestors are updated here
+    for (size_t position = (size_t)end; position < staged;) {
+        size_t offset = (size_t)imageRead(radix->memory + position + 1, sizeof(uint64_t));
+        size_t size = (size_t)imageRead(radix->memory + position + 9, sizeof(uint64_t));
 
-    return meta->structureEnd;
+        Node *node = (Node *) (radix->memory + offset);
+
+        if (radix->memory[position] == DELTA_NODE && node->parent != 0)
+            liveUpdate(radix, (Node *) (radix->memory + node->parent));
+
+        position += RADIX_DELTA_RECORD_SIZE + size;
+    }
+
+    return RADIX_SUCCESS;
 }
@@ -0,0 +1,179 @@
+// mmap flags (MAP_ANONYMOUS, MAP_HUGETLB) and syscall are not part of the strict C standard
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+#endif
+
+#include <radix.h>
+
+#include <string.h>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <stdlib.h>
+#endif
+
+// Huge pages are 2 MiB on the common platforms (mapping size is rounded up to them)
+#define RADIX_HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+// NUMA memory policy modes and flags (linux/mempolicy.h, not installed everywhere)
+#define RADIX_MPOL_BIND 2
+#define RADIX_MPOL_INTERLEAVE 3
+#define RADIX_MPOL_F_MEMS_ALLOWED 4
+
+#define RADIX_NUMA_MASK_BITS (sizeof(unsigned long) * 8)
+
+#if defined(__linux__)
+static unsigned long numaAllowed(void)
+{
+    int mode;
+    unsigned long mask = 0;
+
+    // Nodes allowed for the process (without libnuma)
+    if (syscall(SYS_get_mempolicy, &mode, &mask, RADIX_NUMA_MASK_BITS, NULL, RADIX_MPOL_F_MEMS_ALLOWED) != 0)
+        return 1;
+
+    return mask != 0 ? mask : 1;
+}
+
+static void numaApply(unsigned char *memory, size_t memorySize, RadixMemoryOptions *options)
+{
+    unsigned long mask;
+    int mode;
+
+    switch (options->numaPolicy) {
+        case RADIX_NUMA_INTERLEAVE:
+            mode = RADIX_MPOL_INTERLEAVE;
+            mask = numaAllowed();
+            break;
+        case RADIX_NUMA_BIND:
+            if (options->numaNode >= RADIX_NUMA_MASK_BITS)
+                return;
+
+            mode = RADIX_MPOL_BIND;
+            mask = 1UL << options->numaNode;
+            break;
+        default:
+            return;
+    }
+
+    // Policy is only a hint (e.g. single node machines or containers may not allow it)
+    syscall(SYS_mbind, memory, memorySize, mode, &mask, RADIX_NUMA_MASK_BITS, 0);
+}
+#endif
+
+static unsigned char *memoryMap(size_t *memorySize, RadixMemoryOptions *options)
+{
+#if defined(__linux__)
+    unsigned char *memory = MAP_FAILED;
+
+    // Reserved huge pages are used if there are any, otherwise transparent huge pages are requested
+    if (options->hugePages) {
+        size_t hugeMemorySize = (*memorySize + RADIX_HUGE_PAGE_SIZE - 1) / RADIX_HUGE_PAGE_SIZE * RADIX_HUGE_PAGE_SIZE;
+
+        // Huge pages are reserved by the mapping (without the reservation, missing pages would fault on the first touch)
+        memory = mmap(NULL, hugeMemorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (memory != MAP_FAILED)
+            *memorySize = hugeMemorySize;
+    }
+
+    if (memory == MAP_FAILED) {
+        memory = mmap(NULL, *memorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+        if (memory == MAP_FAILED)
+            return NULL;
+
+#ifdef MADV_HUGEPAGE
+        if (options->hugePages)
+            madvise(memory, *memorySize, MADV_HUGEPAGE);
+#endif
+    }
+
+    // Policy has to be set before the pages are touched
+    numaApply(memory, *memorySize, options);
+
+    return memory;
+#elif defined(_WIN32)
+    (void)options;
+
+    return VirtualAlloc(NULL, *memorySize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    (void)options;
+
+    return calloc(1, *memorySize);
+#endif
+}
+
+Radix radixCreateMapped(size_t memorySize, RadixMemoryOptions *options)
+{
+    RadixMemoryOptions defaultOptions = {0};
+
+    if (!options)
+        options = &defaultOptions;
+
+    unsigned char *memory = memoryMap(&memorySize, options);
+
+    if (!memory)
+        return radixCreate(NULL, 0);
+
+    // Mapped memory is filled with zeros - it is the cleared radix state
+    return radixCreate(memory, memorySize);
+}
+
+void radixDestroyMapped(Radix *radix)
+{
+    if (radix->memory) {
+#if defined(__linux__)
+        // Memory size of huge page mappings is already rounded to huge pages
+        munmap(radix->memory, radix->memorySize);
+#elif defined(_WIN32)
+        VirtualFree(radix->memory, 0, MEM_RELEASE);
+#else
+        free(radix->memory);
+#endif
+    }
+
+    *radix = radixCreate(NULL, 0);
+}
+
+size_t radixNumaNodes(void)
+{
+#if defined(__linux__)
+    unsigned long mask = numaAllowed();
+
+    size_t nodes = 0;
+
+    for (size_t i = 0; i < RADIX_NUMA_MASK_BITS; i++) {
+        if (mask & (1UL << i))
+            nodes = i + 1;
+    }
+
+    return nodes;
+#else
+    return 1;
+#endif
+}
+
+Radix radixCreateReplica(Radix *radix, RadixMemoryOptions *options)
+{
+    // All addresses in the structure are relative, so the used memory is simply copied
+    size_t memoryUsage = radixMemoryUsage(radix);
+
+    Radix replica = radixCreateMapped(memoryUsage, options);
+
+    if (replica.memory) {
+        memcpy(replica.memory, radix->memory, memoryUsage);
+
+        replica.valueLog = radix->valueLog;
+        replica.valueLogSize = radix->valueLogSize;
+        replica.clock = radix->clock;
+        replica.clockContext = radix->clockContext;
+    }
+
+    return replica;
+}
@@ -2,6 +2,11 @@
 #include <string.h>
 #include <stdlib.h>
 
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <stdatomic.h>
+#endif
+
 #include <radix.h>
 
 typedef struct TestCase {
@@ -9,6 +14,104 @@ typedef struct TestCase {
     unsigned char *data;
 } TestCase;
 
+static void batchCallback(void *context, RadixValue *value)
+{
+    size_t *completed = context;
+
+    if (!radixValueIsEmpty(value))
+        (*completed)++;
+}
+
+static void releaseCallback(void *context, unsigned char *data, size_t dataSize)
+{
+    size_t *released = context;
+
+    (*released)++;
+}
+
+static uint64_t testClock(void *context)
+{
+    uint64_t *time = context;
+
+    // Every call advances the time, so each indexed item has its own time
+    return (*time)++;
+}
+
+static uint64_t testFixedClock(void *context)
+{
+    // Time is advanced only by the test
+    return *(uint64_t *)context;
+}
+
+typedef struct TestStream {
+    unsigned char memory[4096];
+    size_t size;
+    size_t position;
+} TestStream;
+
+static bool streamWrite(void *context, unsigned char *data, size_t size)
+{
+    TestStream *stream = context;
+
+    if (size > sizeof(stream->memory) - stream->size)
+        return false;
+
+    memcpy(stream->memory + stream->size, data, size);
+    stream->size += size;
+
+    return true;
+}
+
+static size_t streamRead(void *context, unsigned char *data, size_t size)
+{
+    TestStream *stream = context;
+
+    if (size > stream->size - stream->position)
+        size = stream->size - stream->position;
+
+    memcpy(data, stream->memory + stream->position, size);
+    stream->position += size;
+
+    return size;
+}
+
+#ifndef _WIN32
+#define TEST_PRODUCERS 4
+#define TEST_PRODUCER_KEYS 2000
+
+typedef struct TestProducer {
+    RadixBatch *batch;
+    atomic_size_t *finished;
+
+    unsigned char keys[TEST_PRODUCER_KEYS][16];
+    size_t completed[TEST_PRODUCER_KEYS];
+} TestProducer;
+
+static void producerCallback(void *context, RadixValue *value)
+{
+    size_t *completed = context;
+
+    if (!radixValueIsEmpty(value))
+        (*completed)++;
+}
+
+static void *producerRun(void *context)
+{
+    TestProducer *producer = context;
+
+    for (size_t i = 0; i < TEST_PRODUCER_KEYS; i++) {
+        unsigned char *key = producer->keys[i];
+
+        // Full queue is drained by the writer ..retry the push
+        while (radixBatchPush(producer->batch, key, strlen(key) * 8, key, strlen(key) + 1, producerCallback, &producer->completed[i]) == RADIX_OUT_OF_MEMORY);
+    }
+
+    atomic_fetch_add(producer->finished, 1);
+
+    return NULL;
+}
+#endif
+
 int main()
 {
     // Prepare radix
@@ -266,7 +369,1493 @@ int main()
     printf("\n");
 
     // Show radixMemoryUsage functionality
-    printf("Radix Memory Usage: %lld", radixMemoryUsage(&radix));
+    printf("Radix Memory Usage: %lld\n", radixMemoryUsage(&radix));
+    printf("\n");
+
+    // Show radixPartition, radixPartCreate, radixPartsStitch functionality
+    printf("Parallel build (parts stitched):\n");
+    {
+        size_t stitchedMemorySize = 1024 * 1024; // 1 MiB
+        unsigned char *stitchedMemory = malloc(stitchedMemorySize);
+
+        Radix stitched = radixCreate(stitchedMemory, stitchedMemorySize);
+
+        RadixIterator iterator = radixIterator(&stitched);
+
+        size_t partitionBits = 8;
+        size_t partCount = (size_t)1 << partitionBits;
+
+        Radix parts[1 << 8];
+
+        for (size_t part = 0; part < partCount; part++) {
+            parts[part] = radixPartCreate(&stitched, part, partitionBits);
+
+            if (radixClear(&parts[part])) {
+                printf("ERROR (Part Clear): Out of memory!\n");
+                return -1;
+            }
+        }
+
+        // Each part could be built on its own thread
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *key = cases[i].key + 4; // skip "Key-" so the keys spread over parts
+            size_t keyBits = strlen(key) * 8;
+
+            size_t part = radixPartition(key, keyBits, partitionBits);
+
+            if (part >= partCount)
+                continue;
+
+            RadixIterator partIterator = radixIterator(&parts[part]);
+
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue insertValue = radixInsert(&partIterator, key, keyBits, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Part Insert): Out of memory! (key: %s)\n", key);
+                return -1;
+            }
+        }
+
+        if (radixPartsStitch(&stitched, parts, partitionBits)) {
+            printf("ERROR (Stitch): Parts could not be stitched!\n");
+            return -1;
+        }
+
+        // Keys shorter than partitionBits are inserted after stitching
+        RadixValue shortValue = radixInsert(&iterator, "", 0, "empty key", strlen("empty key") + 1);
+
+        if (radixValueIsEmpty(&shortValue)) {
+            printf("ERROR (Insert): Out of memory! (key: \"\")\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *key = cases[i].key + 4;
+
+            RadixMatch match = radixMatchNullable(&iterator, key, strlen(key) * 8);
+
+            if (radixMatchIsEmpty(&match) || (cases[i].data != NULL && strcmp(match.data, cases[i].data) != 0)) {
+                printf("ERROR (Stitch): Key is missing after stitching! (key: %s)\n", key);
+                return -1;
+            }
+        }
+
+        size_t count = 0;
+
+        for (RadixIterator it = radixNext(&iterator); !radixIteratorIsEmpty(&it); it = radixNext(&it)) {
+            count++;
+        }
+
+        // Number of parts has to be representable
+        Radix invalidPart = radixPartCreate(&stitched, 0, 64);
+
+        if (invalidPart.memory != NULL || radixPartsStitch(&stitched, parts, 64) != RADIX_INVALID_ARGUMENT) {
+            printf("ERROR (Stitch): Invalid partition was accepted!\n");
+            return -1;
+        }
+
+        printf("keys: %zu\tlatest: %s\n", count, radixEarlier(&iterator).data);
+        printf("\n");
+
+        // Stitched structure has only one value log, so parts can not have their own
+        RadixOptions logOptions = { .valueThreshold = 8 };
+
+        for (size_t part = 0; part < partCount; part++) {
+            parts[part] = radixPartCreate(&stitched, part, partitionBits);
+
+            if (part == 0 ? radixClearOptions(&parts[part], &logOptions) : radixClear(&parts[part])) {
+                printf("ERROR (Part Clear): Out of memory!\n");
+                return -1;
+            }
+        }
+
+        if (radixPartsStitch(&stitched, parts, partitionBits) != RADIX_INVALID_ARGUMENT) {
+            printf("ERROR (Stitch): Part with value log was stitched!\n");
+            return -1;
+        }
+
+        // Deduplicated data of parts is shared within the part
+        RadixOptions dedupOptions = { .dedupSlots = 16 };
+
+        unsigned char *dedupKeys[] = { "\001-dedup-a", "\001-dedup-b", "\002-dedup-a", "\002-dedup-b" };
+
+        for (size_t part = 0; part < partCount; part++) {
+            parts[part] = radixPartCreate(&stitched, part, partitionBits);
+
+            if (radixClearOptions(&parts[part], &dedupOptions)) {
+                printf("ERROR (Part Clear): Out of memory!\n");
+                return -1;
+            }
+        }
+
+        for (size_t i = 0; i < sizeof(dedupKeys)/sizeof(dedupKeys[0]); i++) {
+            RadixIterator partIterator = radixIterator(&parts[radixPartition(dedupKeys[i], strlen(dedupKeys[i]) * 8, partitionBits)]);
+
+            radixInsert(&partIterator, dedupKeys[i], strlen(dedupKeys[i]) * 8, "deduplicated value", strlen("deduplicated value") + 1);
+        }
+
+        if (radixPartsStitch(&stitched, parts, partitionBits)) {
+            printf("ERROR (Stitch): Parts could not be stitched!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(dedupKeys)/sizeof(dedupKeys[0]); i++) {
+            RadixMatch match = radixMatch(&iterator, dedupKeys[i], strlen(dedupKeys[i]) * 8);
+
+            if (radixMatchIsEmpty(&match) || strcmp(match.data, "deduplicated value") != 0) {
+                printf("ERROR (Stitch): Deduplicated value is damaged after stitching!\n");
+                return -1;
+            }
+        }
+
+        free(stitchedMemory);
+    }
+
+    // Show radixShardsCreate, radixShardsInsert, radixShardsMatch, radixShardsNext functionality
+    printf("Shards next (keys routed by leading bits):\n");
+    {
+        size_t shardBits = 7;
+        size_t shardCount = (size_t)1 << shardBits;
+        size_t shardMemorySize = 1024 * 8; // 8 KiB per shard
+        unsigned char *shardsMemory = malloc(shardCount * shardMemorySize);
+
+        Radix shardArray[1 << 7];
+
+        for (size_t shard = 0; shard < shardCount; shard++) {
+            shardArray[shard] = radixCreate(shardsMemory + shard * shardMemorySize, shardMemorySize);
+
+            if (radixClear(&shardArray[shard])) {
+                printf("ERROR (Shard Clear): Out of memory!\n");
+                return -1;
+            }
+        }
+
+        RadixShards shards = radixShardsCreate(shardArray, shardBits);
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *key = cases[i].key + 4; // skip "Key-" so the keys spread over shards
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue insertValue = radixShardsInsert(&shards, key, strlen(key) * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Shard Insert): Out of memory! (key: %s)\n", key);
+                return -1;
+            }
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *key = cases[i].key + 4;
+
+            RadixMatch match = radixShardsMatchNullable(&shards, key, strlen(key) * 8);
+
+            if (radixMatchIsEmpty(&match)) {
+                printf("ERROR (Shard Match): Key is missing! (key: %s)\n", key);
+                return -1;
+            }
+        }
+
+        RadixIterator shardIterator = radixIterator(&shardArray[0]);
+
+        for (RadixIterator it = radixShardsNext(&shards, &shardIterator); !radixIteratorIsEmpty(&it); it = radixShardsNext(&shards, &it)) {
+            printf("shard: %zu\tdata: %s\n", (size_t)(it.radix - shardArray), it.data);
+        }
+        printf("\n");
+
+        free(shardsMemory);
+    }
+
+    // Show radixBatchCreate, radixBatchPush, radixBatchApply functionality
+    printf("Batch (queued inserts applied by writer):\n");
+    {
+        if (radixClear(&radix)) {
+            printf("ERROR (Clear): Out of memory!\n");
+            return -1;
+        }
+
+        RadixBatchEntry entries[64];
+        RadixBatch batch = radixBatchCreate(entries, sizeof(entries)/sizeof(entries[0]));
+
+        size_t completed = 0;
+
+        // Producers push in any order, the same key keeps the order of pushing
+        for (size_t i = sizeof(cases)/sizeof(cases[0]); i > 0; i--) {
+            unsigned char *key = cases[i - 1].key;
+            unsigned char *data = cases[i - 1].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            if (radixBatchPush(&batch, key, strlen(key) * 8, data, dataSize, batchCallback, &completed)) {
+                printf("ERROR (Batch Push): Queue is full!\n");
+                return -1;
+            }
+        }
+
+        radixBatchPush(&batch, "Key-a", strlen("Key-a") * 8, "Value-a updated", strlen("Value-a updated") + 1, batchCallback, &completed);
+
+        if (radixBatchApply(&batch, &radix)) {
+            printf("ERROR (Batch Apply): Out of memory!\n");
+            return -1;
+        }
+
+        RadixMatch match = radixMatch(&iterator, "Key-a", strlen("Key-a") * 8);
+
+        if (completed != sizeof(cases)/sizeof(cases[0]) + 1 || radixMatchIsEmpty(&match) || strcmp(match.data, "Value-a updated") != 0) {
+            printf("ERROR (Batch Apply): Batch was not applied in order!\n");
+            return -1;
+        }
+
+        // Ring entries are freed by apply ..pushes wrap around, the full ring refuses the push
+        RadixBatchEntry ringEntries[3];
+        RadixBatch ring = radixBatchCreate(ringEntries, sizeof(ringEntries)/sizeof(ringEntries[0]));
+
+        unsigned char *rounds[] = { "Round-0", "Round-1", "Round-2", "Round-3", "Round-4" };
+
+        for (size_t round = 0; round < sizeof(rounds)/sizeof(rounds[0]); round++) {
+            for (size_t i = 0; i < sizeof(ringEntries)/sizeof(ringEntries[0]); i++) {
+                if (radixBatchPush(&ring, cases[i].key, strlen(cases[i].key) * 8, rounds[round], strlen(rounds[round]) + 1, batchCallback, &completed)) {
+                    printf("ERROR (Batch Ring): Queue is full! (round: %zu)\n", round);
+                    return -1;
+                }
+            }
+
+            if (radixBatchPush(&ring, "Key-a", strlen("Key-a") * 8, rounds[round], strlen(rounds[round]) + 1, batchCallback, &completed) != RADIX_OUT_OF_MEMORY) {
+                printf("ERROR (Batch Ring): Full queue accepted the push!\n");
+                return -1;
+            }
+
+            if (radixBatchApply(&ring, &radix)) {
+                printf("ERROR (Batch Ring): Out of memory!\n");
+                return -1;
+            }
+        }
+
+        RadixMatch ringMatch = radixMatch(&iterator, cases[0].key, strlen(cases[0].key) * 8);
+
+        if (radixMatchIsEmpty(&ringMatch) || strcmp(ringMatch.data, rounds[sizeof(rounds)/sizeof(rounds[0]) - 1]) != 0) {
+            printf("ERROR (Batch Ring): Last round was not applied!\n");
+            return -1;
+        }
+
+        printf("completed: %zu\tKey-a: %s\n", completed, match.data);
+        printf("\n");
+    }
+
+    // Show radixBatchPush of concurrent producers
+#ifndef _WIN32
+    printf("Batch (concurrent producers):\n");
+    {
+        size_t concurrentMemorySize = 1024 * 1024 * 4; // 4 MiB
+        unsigned char *concurrentMemory = malloc(concurrentMemorySize);
+
+        Radix concurrentRadix = radixCreate(concurrentMemory, concurrentMemorySize);
+        RadixIterator concurrentIterator = radixIterator(&concurrentRadix);
+
+        RadixBatchEntry entries[64];
+        RadixBatch batch = radixBatchCreate(entries, sizeof(entries)/sizeof(entries[0]));
+
+        atomic_size_t finished = 0;
+
+        static TestProducer producers[TEST_PRODUCERS];
+        pthread_t threads[TEST_PRODUCERS];
+
+        for (size_t p = 0; p < TEST_PRODUCERS; p++) {
+            producers[p].batch = &batch;
+            producers[p].finished = &finished;
+
+            for (size_t i = 0; i < TEST_PRODUCER_KEYS; i++) {
+                snprintf(producers[p].keys[i], sizeof(producers[p].keys[i]), "Key-%zu-%zu", p, i);
+                producers[p].completed[i] = 0;
+            }
+        }
+
+        for (size_t p = 0; p < TEST_PRODUCERS; p++) {
+            if (pthread_create(&threads[p], NULL, producerRun, &producers[p])) {
+                printf("ERROR (Batch Concurrent): Thread was not created!\n");
+                return -1;
+            }
+        }
+
+        // Writer applies while producers push ..the apply after all producers finished takes the rest
+        size_t batches = 0;
+
+        while (true) {
+            size_t producersFinished = atomic_load(&finished);
+            size_t head = batch.head;
+
+            if (radixBatchApply(&batch, &concurrentRadix)) {
+                printf("ERROR (Batch Concurrent): Out of memory!\n");
+                return -1;
+            }
+
+            if (batch.head != head)
+                batches++;
+
+            if (producersFinished == TEST_PRODUCERS && batch.head == head)
+                break;
+        }
+
+        for (size_t p = 0; p < TEST_PRODUCERS; p++) {
+            pthread_join(threads[p], NULL);
+        }
+
+        // Every pushed entry is applied exactly once
+        for (size_t p = 0; p < TEST_PRODUCERS; p++) {
+            for (size_t i = 0; i < TEST_PRODUCER_KEYS; i++) {
+                unsigned char *key = producers[p].keys[i];
+
+                if (producers[p].completed[i] != 1) {
+                    printf("ERROR (Batch Concurrent): Entry was completed %zu times! (key: %s)\n", producers[p].completed[i], key);
+                    return -1;
+                }
+
+                RadixMatch match = radixMatch(&concurrentIterator, key, strlen(key) * 8);
+
+                if (radixMatchIsEmpty(&match) || strcmp(match.data, key) != 0) {
+                    printf("ERROR (Batch Concurrent): Entry was lost! (key: %s)\n", key);
+                    return -1;
+                }
+            }
+        }
+
+        size_t count = 0;
+
+        for (RadixIterator it = radixNext(&concurrentIterator); !radixIteratorIsEmpty(&it); it = radixNext(&it)) {
+            count++;
+        }
+
+        if (count != TEST_PRODUCERS * TEST_PRODUCER_KEYS || batch.head != count) {
+            printf("ERROR (Batch Concurrent): Wrong number of entries! (count: %zu)\n", count);
+            return -1;
+        }
+
+        printf("producers: %d\tentries: %zu\tbatches: %zu\n", TEST_PRODUCERS, count, batches);
+        printf("\n");
+
+        free(concurrentMemory);
+    }
+#endif
+
+    // Show radixFinger, radixFingerInsert, radixFingerMatch functionality
+    printf("Finger (operations resumed from the last position):\n");
+    {
+        if (radixClear(&radix)) {
+            printf("ERROR (Clear): Out of memory!\n");
+            return -1;
+        }
+
+        unsigned char fingerKey[32];
+        RadixFinger finger = radixFinger(&radix, fingerKey, sizeof(fingerKey));
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue insertValue = radixFingerInsert(&finger, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Finger Insert): Out of memory! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixMatch match = radixFingerMatch(&finger, cases[i].key, strlen(cases[i].key) * 8);
+
+            if (radixMatchIsEmpty(&match) != (cases[i].data == NULL) || (cases[i].data && strcmp(match.data, cases[i].data) != 0)) {
+                printf("ERROR (Finger Match): Wrong match! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+
+            printf("key: %s\tvalue: %s\n", cases[i].key, match.data);
+        }
+        printf("\n");
+    }
+
+    // Show radixClearOptions (exact-match hash index) functionality
+    printf("Indexed match:\n");
+    {
+        RadixOptions options = { .indexSlots = 64 };
+
+        if (radixClearOptions(&radix, &options)) {
+            printf("ERROR (Clear Options): Out of memory!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue insertValue = radixInsert(&iterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                return -1;
+            }
+        }
+
+        RadixCheckpoint checkpoint = radixCheckpoint(&radix);
+
+        radixInsert(&iterator, "Key-new", strlen("Key-new") * 8, "Value-new", strlen("Value-new") + 1);
+
+        radixCheckpointRestore(&radix, &checkpoint);
+
+        RadixMatch restoredMatch = radixMatchNullable(&iterator, "Key-new", strlen("Key-new") * 8);
+
+        if (!radixMatchIsEmpty(&restoredMatch)) {
+            printf("ERROR (Indexed Match): Restored key is still indexed!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixMatch match = radixMatchNullable(&iterator, cases[i].key, strlen(cases[i].key) * 8);
+
+            if (radixMatchIsEmpty(&match) || (cases[i].data && strcmp(match.data, cases[i].data) != 0)) {
+                printf("ERROR (Indexed Match): Wrong match! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+
+            printf("key: %s\tvalue: %s\n", cases[i].key, match.data);
+        }
+        printf("\n");
+    }
+
+    // Show radixClearOptions (bloom filter), radixFilterStats functionality
+    printf("Filtered match:\n");
+    {
+        RadixOptions options = { .filterBits = 2048 };
+
+        if (radixClearOptions(&radix, &options)) {
+            printf("ERROR (Clear Options): Out of memory!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue insertValue = radixInsert(&iterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                return -1;
+            }
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixMatch match = radixMatchNullable(&iterator, cases[i].key, strlen(cases[i].key) * 8);
+
+            if (radixMatchIsEmpty(&match)) {
+                printf("ERROR (Filtered Match): Key was rejected! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+        }
+
+        RadixMatch missingMatch = radixMatch(&iterator, "Key-missing", strlen("Key-missing") * 8);
+
+        if (!radixMatchIsEmpty(&missingMatch)) {
+            printf("ERROR (Filtered Match): Missing key was matched!\n");
+            return -1;
+        }
+
+        RadixFilterStats stats = radixFilterStats(&radix);
+
+        printf("keys: %zu\tbits set: %zu/%zu\tfalse positive rate: %f\n", stats.keys, stats.bitsSet, stats.bits, stats.falsePositiveRate);
+        printf("\n");
+    }
+
+    // Show radixInsertReference functionality
+    printf("Referenced values:\n");
+    {
+        radixClear(&radix);
+
+        RadixCheckpoint checkpoint = radixCheckpoint(&radix);
+
+        size_t released = 0;
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue insertValue = radixInsertReference(&iterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize, releaseCallback, &released);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Insert Reference): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                return -1;
+            }
+        }
+
+        size_t referenced = 0;
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixMatch match = radixMatch(&iterator, cases[i].key, strlen(cases[i].key) * 8);
+
+            if (cases[i].data && (radixMatchIsEmpty(&match) || match.data != (unsigned char *)cases[i].data)) {
+                printf("ERROR (Insert Reference): Data was copied! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+
+            if (cases[i].data)
+                referenced++;
+        }
+
+        radixCheckpointRestore(&radix, &checkpoint);
+
+        if (released != referenced) {
+            printf("ERROR (Insert Reference): Wrong release count! (%zu/%zu)\n", released, referenced);
+            return -1;
+        }
+
+        printf("referenced: %zu\treleased: %zu\tmemory usage: %zu\n", referenced, released, radixMemoryUsage(&radix));
+        printf("\n");
+    }
+
+    // Show radixCreateValueLog, radixValueLogCollect functionality
+    printf("Value log:\n");
+    {
+        unsigned char *valueLogs[2] = { malloc(1024), malloc(1024) };
+
+        Radix logRadix = radixCreateValueLog(radixMemory, radixMemorySize, valueLogs[0], 1024);
+        RadixIterator logIterator = radixIterator(&logRadix);
+
+        RadixOptions options = { .valueThreshold = 8 };
+
+        if (radixClearOptions(&logRadix, &options)) {
+            printf("ERROR (Clear Options): Out of memory!\n");
+            return -1;
+        }
+
+        // Insert every value twice (the first versions are shadowed)
+        for (size_t round = 0; round < 2; round++) {
+            for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+                unsigned char *data = cases[i].data;
+                size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+                RadixValue insertValue = radixInsert(&logIterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+                if (radixValueIsEmpty(&insertValue)) {
+                    printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                    return -1;
+                }
+            }
+        }
+
+        size_t usedLog = radixValueLogUsage(&logRadix);
+
+        RadixCheckpoint horizon = radixCheckpoint(&logRadix);
+
+        if (radixValueLogCollect(&logRadix, &horizon, valueLogs[1], 1024)) {
+            printf("ERROR (Value Log Collect): Out of memory!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixMatch match = radixMatch(&logIterator, cases[i].key, strlen(cases[i].key) * 8);
+
+            if (cases[i].data && (radixMatchIsEmpty(&match) || match.data < valueLogs[1] || match.data >= valueLogs[1] + 1024 || strcmp(match.data, cases[i].data) != 0)) {
+                printf("ERROR (Value Log): Wrong match! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+        }
+
+        printf("value log usage: %zu -> %zu\tmemory usage: %zu\n", usedLog, radixValueLogUsage(&logRadix), radixMemoryUsage(&logRadix));
+        printf("\n");
+
+        free(valueLogs[0]);
+        free(valueLogs[1]);
+    }
+
+    // Show radixClearOptions (data deduplication) functionality
+    printf("Deduplicated values:\n");
+    {
+        unsigned char *sharedData = "Value-shared-by-all-keys";
+        size_t sharedDataSize = strlen(sharedData) + 1;
+
+        size_t memoryUsage[2];
+
+        for (size_t dedup = 0; dedup < 2; dedup++) {
+            RadixOptions options = { .dedupSlots = dedup ? 8 : 0 };
+
+            if (radixClearOptions(&radix, &options)) {
+                printf("ERROR (Clear Options): Out of memory!\n");
+                return -1;
+            }
+
+            RadixValue firstValue = radixValueIterator(&radix);
+
+            for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+                RadixValue insertValue = radixInsert(&iterator, cases[i].key, strlen(cases[i].key) * 8, sharedData, sharedDataSize);
+
+                if (radixValueIsEmpty(&insertValue)) {
+                    printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, sharedData);
+                    return -1;
+                }
+
+                if (i == 0)
+                    firstValue = insertValue;
+
+                if (dedup && insertValue.data != firstValue.data) {
+                    printf("ERROR (Deduplication): Data was copied! (key: %s)\n", cases[i].key);
+                    return -1;
+                }
+            }
+
+            memoryUsage[dedup] = radixMemoryUsage(&radix);
+        }
+
+        printf("memory usage: %zu -> %zu\n", memoryUsage[0], memoryUsage[1]);
+        printf("\n");
+    }
+
+    // Show radixClearOptions (compression), radixValueRead functionality
+    printf("Compressed values:\n");
+    {
+        RadixOptions options = { .compressThreshold = 32 };
+
+        if (radixClearOptions(&radix, &options)) {
+            printf("ERROR (Clear Options): Out of memory!\n");
+            return -1;
+        }
+
+        // Text value repeating the key
+        unsigned char data[128];
+        unsigned char output[128];
+
+        size_t dataSize = 0;
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            size_t keySize = strlen(cases[i].key);
+
+            for (dataSize = 0; dataSize < sizeof(data); dataSize++) {
+                data[dataSize] = cases[i].key[dataSize % keySize];
+            }
+
+            RadixValue insertValue = radixInsert(&iterator, cases[i].key, keySize * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Insert): Out of memory! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+
+            if (insertValue.data != NULL || radixValueRead(&insertValue, output, sizeof(output)) || memcmp(data, output, dataSize) != 0) {
+                printf("ERROR (Value Read): Wrong data! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+        }
+
+        printf("values: %zu x %zu bytes\tmemory usage: %zu\n", sizeof(cases)/sizeof(cases[0]), dataSize, radixMemoryUsage(&radix));
+        printf("\n");
+    }
+
+    // Show radixClearOptions (key fragment sharing) functionality
+    printf("Shared key fragments:\n");
+    {
+        size_t memoryUsage[2];
+
+        for (size_t fragments = 0; fragments < 2; fragments++) {
+            RadixOptions options = { .fragmentSlots = fragments ? 64 : 0 };
+
+            if (radixClearOptions(&radix, &options)) {
+                printf("ERROR (Clear Options): Out of memory!\n");
+                return -1;
+            }
+
+            size_t optionsMemory = radixMemoryUsage(&radix);
+
+            // Keys with the same suffix in different subtrees
+            for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+                char key[64];
+
+                snprintf(key, sizeof(key), "%s/index.html", cases[i].key);
+
+                RadixValue insertValue = radixInsert(&iterator, key, strlen(key) * 8, NULL, 0);
+
+                if (radixValueIsEmpty(&insertValue)) {
+                    printf("ERROR (Insert): Out of memory! (key: %s)\n", key);
+                    return -1;
+                }
+
+                RadixMatch match = radixMatchNullable(&iterator, key, strlen(key) * 8);
+
+                if (radixMatchIsEmpty(&match)) {
+                    printf("ERROR (Shared Key Fragments): Key was not matched! (key: %s)\n", key);
+                    return -1;
+                }
+            }
+
+            memoryUsage[fragments] = radixMemoryUsage(&radix) - optionsMemory;
+        }
+
+        printf("keys memory usage: %zu -> %zu\n", memoryUsage[0], memoryUsage[1]);
+        printf("\n");
+    }
+
+    // Show radixFreeze functionality
+    printf("Frozen structure:\n");
+    {
+        radixClear(&radix);
+
+        // Memory of the cleared structure (meta) is taken by both structures
+        size_t clearUsage = radixMemoryUsage(&radix);
+        size_t liveUsage = 0;
+
+        // Insert every value twice (the first versions stay in history)
+        for (size_t round = 0; round < 2; round++) {
+            for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+                unsigned char *data = cases[i].data;
+                size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+                RadixValue insertValue = radixInsert(&iterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+                if (radixValueIsEmpty(&insertValue)) {
+                    printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                    return -1;
+                }
+            }
+
+            // Memory of the values without history is compared with the frozen copy
+            if (round == 0)
+                liveUsage = radixMemoryUsage(&radix);
+        }
+
+        unsigned char *frozenMemory = malloc(radixMemorySize);
+
+        Radix frozen = radixCreate(frozenMemory, radixMemorySize);
+        RadixIterator frozenIterator = radixIterator(&frozen);
+
+        if (radixFreeze(&radix, &frozen)) {
+            printf("ERROR (Freeze): Out of memory!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixMatch match = radixMatch(&frozenIterator, cases[i].key, strlen(cases[i].key) * 8);
+
+            if (radixMatchIsEmpty(&match) != (cases[i].data == NULL) || (cases[i].data && strcmp(match.data, cases[i].data) != 0)) {
+                printf("ERROR (Freeze): Wrong match! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+        }
+
+        // Frozen records are iterated in the same order, their keys are copied the same way
+        RadixIterator liveIt = radixIterator(&radix);
+        RadixIterator frozenIt = radixIterator(&frozen);
+
+        do {
+            liveIt = radixPrev(&liveIt);
+            frozenIt = radixPrev(&frozenIt);
+
+            unsigned char liveKey[16] = {0};
+            unsigned char frozenKey[16] = {0};
+
+            radixKeyCopy(&liveIt, liveKey, radixKeyBits(&liveIt));
+            radixKeyCopy(&frozenIt, frozenKey, radixKeyBits(&frozenIt));
+
+            RadixIterator livePredecessor = radixPredecessor(&liveIt);
+            RadixIterator frozenPredecessor = radixPredecessor(&frozenIt);
+
+            if (radixKeyBits(&liveIt) != radixKeyBits(&frozenIt) || memcmp(liveKey, frozenKey, sizeof(liveKey)) != 0 || liveIt.dataSize != frozenIt.dataSize || radixKeyBits(&livePredecessor) != radixKeyBits(&frozenPredecessor)) {
+                printf("ERROR (Freeze): Wrong iteration! (key: %s)\n", liveKey);
+                return -1;
+            }
+        } while (!radixIteratorIsEmpty(&liveIt));
+
+        RadixMatch frozenLongest = radixMatchLongest(&frozenIterator, "Key-abcd", strlen("Key-abcd") * 8);
+
+        if (radixMatchIsEmpty(&frozenLongest) || strcmp(frozenLongest.data, " Value-abc") != 0) {
+            printf("ERROR (Freeze): Wrong longest match!\n");
+            return -1;
+        }
+
+        RadixValue frozenValue = radixInsert(&frozenIterator, "Key-new", strlen("Key-new") * 8, "Value-new", strlen("Value-new") + 1);
+
+        if (!radixValueIsEmpty(&frozenValue)) {
+            printf("ERROR (Freeze): Frozen structure was modified!\n");
+            return -1;
+        }
+
+        // Frozen records have no chronology
+        RadixIterator earlier = radixEarlier(&frozenIterator);
+
+        if (!radixIteratorIsEmpty(&earlier)) {
+            printf("ERROR (Freeze): Frozen structure has chronology!\n");
+            return -1;
+        }
+
+        // Records are at least 3x smaller than nodes and items
+        size_t frozenUsage = radixMemoryUsage(&frozen);
+
+        if ((frozenUsage - clearUsage) * 3 > liveUsage - clearUsage) {
+            printf("ERROR (Freeze): Frozen structure is not compact! (%zu * 3 > %zu)\n", frozenUsage - clearUsage, liveUsage - clearUsage);
+            return -1;
+        }
+
+        printf("memory usage: %zu -> %zu\tratio (without history and meta): %.2f\n", radixMemoryUsage(&radix), frozenUsage, (double)(liveUsage - clearUsage) / (frozenUsage - clearUsage));
+        printf("\n");
+
+        free(frozenMemory);
+    }
+
+    // Show radixClearOptions (aligned nodes) functionality
+    printf("Aligned nodes:\n");
+    {
+        // Cache lines are counted from the memory start ..aligned nodes need the memory aligned to the line
+        unsigned char *alignedBuffer = malloc(radixMemorySize + 64);
+        unsigned char *alignedMemory = alignedBuffer + (64 - (uintptr_t)alignedBuffer % 64) % 64;
+
+        Radix alignedRadix = radixCreate(alignedMemory + 8, radixMemorySize - 8);
+        RadixOptions unalignedOptions = { .alignNodes = true };
+
+        if (radixClearOptions(&alignedRadix, &unalignedOptions) != RADIX_INVALID_ARGUMENT) {
+            printf("ERROR (Aligned Nodes): Unaligned memory was accepted!\n");
+            return -1;
+        }
+
+        alignedRadix = radixCreate(alignedMemory, radixMemorySize);
+        RadixIterator alignedIterator = radixIterator(&alignedRadix);
+
+        size_t memoryUsage[2];
+
+        for (size_t aligned = 0; aligned < 2; aligned++) {
+            RadixOptions options = { .alignNodes = aligned };
+
+            if (radixClearOptions(&alignedRadix, &options)) {
+                printf("ERROR (Clear Options): Out of memory!\n");
+                return -1;
+            }
+
+            for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+                unsigned char *data = cases[i].data;
+                size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+                RadixValue insertValue = radixInsert(&alignedIterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+                if (radixValueIsEmpty(&insertValue)) {
+                    printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                    return -1;
+                }
+            }
+
+            for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+                RadixMatch match = radixMatchNullable(&alignedIterator, cases[i].key, strlen(cases[i].key) * 8);
+
+                if (radixMatchIsEmpty(&match) || (cases[i].data && strcmp(match.data, cases[i].data) != 0)) {
+                    printf("ERROR (Aligned Nodes): Wrong match! (key: %s)\n", cases[i].key);
+                    return -1;
+                }
+            }
+
+            memoryUsage[aligned] = radixMemoryUsage(&alignedRadix);
+        }
+
+        printf("memory usage: %zu -> %zu\n", memoryUsage[0], memoryUsage[1]);
+        printf("\n");
+
+        free(alignedBuffer);
+    }
+
+    // Show radixCreateMapped, radixCreateReplica functionality
+    printf("Mapped memory:\n");
+    {
+        RadixMemoryOptions memoryOptions = { .hugePages = true, .numaPolicy = RADIX_NUMA_INTERLEAVE };
+
+        Radix mapped = radixCreateMapped(radixMemorySize, &memoryOptions);
+        RadixIterator mappedIterator = radixIterator(&mapped);
+
+        if (!mapped.memory) {
+            printf("ERROR (Create Mapped): Memory was not mapped!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue insertValue = radixInsert(&mappedIterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                return -1;
+            }
+        }
+
+        // Replica for each NUMA node
+        size_t numaNodes = radixNumaNodes();
+
+        for (size_t node = 0; node < numaNodes; node++) {
+            RadixMemoryOptions replicaOptions = { .hugePages = true, .numaPolicy = RADIX_NUMA_BIND, .numaNode = node };
+
+            Radix replica = radixCreateReplica(&mapped, &replicaOptions);
+            RadixIterator replicaIterator = radixIterator(&replica);
+
+            if (!replica.memory) {
+                printf("ERROR (Create Replica): Memory was not mapped!\n");
+                return -1;
+            }
+
+            for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+                RadixMatch match = radixMatchNullable(&replicaIterator, cases[i].key, strlen(cases[i].key) * 8);
+
+                if (radixMatchIsEmpty(&match) || (cases[i].data && strcmp(match.data, cases[i].data) != 0)) {
+                    printf("ERROR (Create Replica): Wrong match! (key: %s)\n", cases[i].key);
+                    return -1;
+                }
+            }
+
+            radixDestroyMapped(&replica);
+        }
+
+        printf("mapped memory: %zu\tNUMA nodes: %zu\n", mapped.memorySize, numaNodes);
+        printf("\n");
+
+        radixDestroyMapped(&mapped);
+    }
+
+    // Show radixStats functionality
+    printf("Structure stats:\n");
+    {
+        radixClear(&radix);
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue insertValue = radixInsert(&iterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                return -1;
+            }
+        }
+
+        // Overwrite the first key, so it has a shadowed value
+        radixInsert(&iterator, cases[0].key, strlen(cases[0].key) * 8, "Overwritten", strlen("Overwritten") + 1);
+
+        RadixStats stats = radixStats(&radix, false);
+        RadixStats walkStats = radixStats(&radix, true);
+
+        if (stats.nodes != walkStats.nodes || stats.items != walkStats.items || stats.liveItems != walkStats.liveItems || stats.keyBytes != walkStats.keyBytes || stats.deadBytes != walkStats.deadBytes) {
+            printf("ERROR (Stats): Counters differ from the full walk!\n");
+            return -1;
+        }
+
+        if (stats.shadowedItems == 0 || walkStats.maxDepth == 0) {
+            printf("ERROR (Stats): Wrong stats!\n");
+            return -1;
+        }
+
+        printf("nodes: %zu\tsplit ratio: %f\titems: %zu (live: %zu, shadowed: %zu, null: %zu)\n", stats.nodes, stats.splitRatio, stats.items, stats.liveItems, stats.shadowedItems, stats.nullItems);
+        printf("key bytes: %zu\tvalue bytes: %zu\tdead bytes: %zu\tdepth: %f (max: %zu)\n", stats.keyBytes, stats.valueBytes, stats.deadBytes, walkStats.averageDepth, walkStats.maxDepth);
+        printf("\n");
+    }
+
+    // Show radixCounters functionality (counted only by builds with RADIX_STATS)
+    printf("Instrumentation counters:\n");
+    {
+        radixCountersReset();
+
+        RadixCounters resetCounters = radixCounters();
+
+        if (resetCounters.nodesVisited != 0 || resetCounters.bitsCompared != 0 || resetCounters.nullItemsSkipped != 0) {
+            printf("ERROR (Counters): Counters were not reset!\n");
+            return -1;
+        }
+
+        RadixMatch match = radixMatch(&iterator, cases[0].key, strlen(cases[0].key) * 8);
+
+        RadixCounters matchCounters = radixCounters();
+
+        radixCountersReset();
+
+        size_t values = 0;
+
+        for (RadixIterator next = radixNext(&iterator); !radixIteratorIsEmpty(&next); next = radixNext(&next)) {
+            values++;
+        }
+
+        RadixCounters nextCounters = radixCounters();
+
+        printf("match: %d\tnodes visited: %zu\tbits compared: %zu\n", !radixMatchIsEmpty(&match), matchCounters.nodesVisited, matchCounters.bitsCompared);
+        printf("values: %zu\tnodes visited: %zu\tnull items skipped: %zu\n", values, nextCounters.nodesVisited, nextCounters.nullItemsSkipped);
+        printf("\n");
+    }
+
+    // Show skipping of subtrees without values by non-nullable iterations
+    printf("Skipped removed values:\n");
+    {
+        RadixCheckpoint checkpoint = radixCheckpoint(&radix);
+
+        // Remove all keys except the last one with data (the last case is null data)
+        size_t lastCase = sizeof(cases)/sizeof(cases[0]) - 2;
+
+        for (size_t i = 0; i < lastCase; i++) {
+            radixRemove(&iterator, cases[i].key, strlen(cases[i].key) * 8);
+        }
+
+        radixCountersReset();
+
+        RadixIterator next = radixNext(&iterator);
+        RadixIterator prev = radixPrev(&iterator);
+
+        RadixCounters counters = radixCounters();
+
+        RadixMatch lastMatch = radixMatch(&iterator, cases[lastCase].key, strlen(cases[lastCase].key) * 8);
+
+        if (radixMatchIsEmpty(&lastMatch) || next.node != lastMatch.node || prev.node != lastMatch.node) {
+            printf("ERROR (Skipped Values): Wrong value!\n");
+            return -1;
+        }
+
+        next = radixNext(&next);
+
+        if (!radixIteratorIsEmpty(&next)) {
+            printf("ERROR (Skipped Values): Removed value was not skipped!\n");
+            return -1;
+        }
+
+        radixCheckpointRestore(&radix, &checkpoint);
+
+        size_t values = 0;
+
+        for (next = radixNext(&iterator); !radixIteratorIsEmpty(&next); next = radixNext(&next)) {
+            values++;
+        }
+
+        printf("value: %s\tnodes visited: %zu\tvalues after restore: %zu\n", lastMatch.data, counters.nodesVisited, values);
+        printf("\n");
+    }
+
+    // Show radixClearOptions (time index), radixTimeCheckpoint, radixValueSeek, radixValueLater functionality
+    printf("Time index:\n");
+    {
+        uint64_t time = 0;
+
+        RadixOptions options = { .timeSlots = 4, .timeStride = 2, .clock = testClock, .clockContext = &time };
+
+        if (radixClearOptions(&radix, &options)) {
+            printf("ERROR (Clear Options): Out of memory!\n");
+            return -1;
+        }
+
+        RadixCheckpoint middle = {0};
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            if (i == sizeof(cases)/sizeof(cases[0]) / 2)
+                middle = radixCheckpoint(&radix);
+
+            RadixValue insertValue = radixInsert(&iterator, cases[i].key, strlen(cases[i].key) * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&insertValue)) {
+                printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", cases[i].key, cases[i].data);
+                return -1;
+            }
+        }
+
+        // Replay values inserted after the checkpoint
+        RadixValue value = radixValueSeek(&radix, &middle);
+
+        if (radixValueIsEmpty(&value) || strcmp(value.data, cases[sizeof(cases)/sizeof(cases[0]) / 2 - 1].data) != 0) {
+            printf("ERROR (Value Seek): Wrong value!\n");
+            return -1;
+        }
+
+        size_t replayed = 0;
+
+        for (value = radixValueLater(&value); !radixValueIsEmpty(&value); value = radixValueLater(&value)) {
+            replayed++;
+        }
+
+        // Values inserted after the checkpoint (the last case is null data)
+        if (replayed != sizeof(cases)/sizeof(cases[0]) - sizeof(cases)/sizeof(cases[0]) / 2 - 1) {
+            printf("ERROR (Value Later): Wrong number of values! (%zu)\n", replayed);
+            return -1;
+        }
+
+        // Find the values indexed until the half of the time
+        RadixCheckpoint timeCheckpoint = radixTimeCheckpoint(&radix, time / 2);
+        RadixValue timeValue = radixValueSeek(&radix, &timeCheckpoint);
+
+        if (radixValueIsEmpty(&timeValue)) {
+            printf("ERROR (Time Checkpoint): No value was found!\n");
+            return -1;
+        }
+
+        printf("replayed: %zu\ttime: %llu\tvalue at time %llu: %s\n", replayed, (unsigned long long)time, (unsigned long long)(time / 2), (char *)timeValue.data);
+        printf("\n");
+    }
+
+    // Show radixClearOptions (versions), radixValueAtVersion, radixValueAsOf functionality
+    printf("Versioned values:\n");
+    {
+        RadixOptions options = { .versions = true };
+
+        if (radixClearOptions(&radix, &options)) {
+            printf("ERROR (Clear Options): Out of memory!\n");
+            return -1;
+        }
+
+        // Every case is the next version of the same key
+        RadixCheckpoint checkpoints[sizeof(cases)/sizeof(cases[0])];
+        RadixValue latest = {0};
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            checkpoints[i] = radixCheckpoint(&radix);
+
+            latest = radixInsert(&iterator, "Key-versioned", strlen("Key-versioned") * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&latest)) {
+                printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", "Key-versioned", cases[i].data);
+                return -1;
+            }
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixValue version = radixValueAtVersion(&latest, i + 1);
+
+            // Value as of the checkpoint is the version inserted before it
+            RadixValue asOf = i != 0 ? radixValueAsOfNullable(&latest, &checkpoints[i]) : version;
+
+            if (radixValueIsEmpty(&version) || (cases[i].data && strcmp(version.data, cases[i].data) != 0) || (i != 0 && radixValueVersion(&asOf) != i)) {
+                printf("ERROR (Versioned Values): Wrong version! (version: %zu)\n", i + 1);
+                return -1;
+            }
+        }
+
+        RadixValue first = radixValueAtVersion(&latest, 1);
+
+        printf("versions: %zu\tfirst version: %s\n", radixValueVersion(&latest), first.data);
+        printf("\n");
+    }
+
+    // Show radixInsertExpiring, radixExpireStep functionality
+    printf("Expiring values:\n");
+    {
+        uint64_t time = 0;
+
+        RadixOptions options = { .expirySlots = 64, .clock = testFixedClock, .clockContext = &time };
+
+        if (radixClearOptions(&radix, &options)) {
+            printf("ERROR (Clear Options): Out of memory!\n");
+            return -1;
+        }
+
+        // Every case expires one time unit after the previous one
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *key = cases[i].key;
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue value = radixInsertExpiring(&iterator, key, strlen(key) * 8, data, dataSize, i + 1);
+
+            if (radixValueIsEmpty(&value)) {
+                printf("ERROR (Insert Expiring): Out of memory! (key: %s, value: %s)\n", key, data);
+                return -1;
+            }
+        }
+
+        time = sizeof(cases)/sizeof(cases[0]) / 2;
+
+        size_t visible = 0;
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *key = cases[i].key;
+
+            RadixMatch match = radixMatch(&iterator, key, strlen(key) * 8);
+
+            // Cases expiring at the time (or earlier) are no longer visible
+            if (!radixMatchIsEmpty(&match) != (cases[i].data != NULL && i + 1 > time)) {
+                printf("ERROR (Match Expiring): Wrong visibility! (key: %s)\n", key);
+                return -1;
+            }
+
+            visible += !radixMatchIsEmpty(&match);
+        }
+
+        // Clock is read once per operation (not for every visited item)
+        uint64_t reads = 0;
+        size_t steps = 0;
+
+        radixSetClock(&radix, testClock, &reads);
+
+        for (RadixIterator it = radixNext(&iterator); !radixIteratorIsEmpty(&it); it = radixNext(&it)) {
+            steps++;
+        }
+
+        radixSetClock(&radix, testFixedClock, &time);
+
+        if (reads != steps + 1) {
+            printf("ERROR (Expiring Next): Clock was read %llu times by %zu steps!\n", (unsigned long long)reads, steps + 1);
+            return -1;
+        }
+
+        // Expired values are shadowed with the bounded budget
+        size_t expired = radixExpireStep(&radix, 2);
+        size_t expiredRest = radixExpireStep(&radix, sizeof(cases)/sizeof(cases[0]));
+
+        if (expired != 2 || expired + expiredRest != time) {
+            printf("ERROR (Expire Step): Wrong number of expired values! (%zu, %zu)\n", expired, expiredRest);
+            return -1;
+        }
+
+        printf("time: %llu\tvisible: %zu\texpired: %zu + %zu\n", (unsigned long long)time, visible, expired, expiredRest);
+        printf("\n");
+    }
+
+    // Show radixClearOptions (cacheMemory) functionality
+    printf("Cache mode:\n");
+    {
+        RadixOptions options = { .cacheMemory = 4096 };
+
+        if (radixClearOptions(&radix, &options)) {
+            printf("ERROR (Clear Options): Out of memory!\n");
+            return -1;
+        }
+
+        // Cases are inserted several times over the budget, the matched key stays cached
+        for (size_t round = 0; round < 4; round++) {
+            for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]) - 1; i++) {
+                unsigned char *key = cases[i].key;
+                unsigned char *data = cases[i].data;
+
+                RadixValue value = radixInsert(&iterator, key, strlen(key) * 8, data, strlen(data) + 1);
+
+                if (radixValueIsEmpty(&value)) {
+                    printf("ERROR (Cache Insert): Out of memory! (key: %s, value: %s)\n", key, data);
+                    return -1;
+                }
+
+                RadixMatch match = radixMatch(&iterator, cases[0].key, strlen(cases[0].key) * 8);
+
+                if (radixMatchIsEmpty(&match)) {
+                    printf("ERROR (Cache Match): Matched key was evicted! (key: %s)\n", cases[0].key);
+                    return -1;
+                }
+            }
+        }
+
+        RadixStats stats = radixStats(&radix, false);
+
+        if (stats.evictions == 0) {
+            printf("ERROR (Cache Mode): Keys were not evicted!\n");
+            return -1;
+        }
+
+        printf("cached: %zu\tevictions: %zu\tmemory usage: %zu\n", stats.liveItems, stats.evictions, radixMemoryUsage(&radix));
+
+        // Cache mode deletes removed keys physically ..the batch with a removal is still applied
+        RadixBatchEntry entries[2];
+        RadixBatch batch = radixBatchCreate(entries, sizeof(entries)/sizeof(entries[0]));
+
+        radixBatchPush(&batch, cases[0].key, strlen(cases[0].key) * 8, NULL, 0, NULL, NULL);
+        radixBatchPush(&batch, "Key-cached", strlen("Key-cached") * 8, "Value-cached", strlen("Value-cached") + 1, NULL, NULL);
+
+        if (radixBatchApply(&batch, &radix)) {
+            printf("ERROR (Cache Batch): Batch with a removal was not applied!\n");
+            return -1;
+        }
+
+        RadixMatch removed = radixMatch(&iterator, cases[0].key, strlen(cases[0].key) * 8);
+        RadixMatch cached = radixMatch(&iterator, "Key-cached", strlen("Key-cached") * 8);
+
+        if (!radixMatchIsEmpty(&removed) || radixMatchIsEmpty(&cached)) {
+            printf("ERROR (Cache Batch): Wrong match after the batch!\n");
+            return -1;
+        }
+        printf("\n");
+    }
+
+    // Show radixExport, radixImport functionality
+    printf("Export and import:\n");
+    {
+        if (radixClear(&radix)) {
+            printf("ERROR (Clear): Out of memory!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            unsigned char *key = cases[i].key;
+            unsigned char *data = cases[i].data;
+            size_t dataSize = data == NULL ? 0 : strlen(data) + 1;
+
+            RadixValue value = radixInsert(&iterator, key, strlen(key) * 8, data, dataSize);
+
+            if (radixValueIsEmpty(&value)) {
+                printf("ERROR (Insert): Out of memory! (key: %s, value: %s)\n", key, data);
+                return -1;
+            }
+        }
+
+        size_t imageSize = radixExportSize(&radix);
+        unsigned char *image = malloc(imageSize);
+
+        if (radixExport(&radix, image, imageSize)) {
+            printf("ERROR (Export): Structure was not exported!\n");
+            return -1;
+        }
+
+        unsigned char *importedMemory = malloc(radixMemorySize);
+
+        Radix imported = radixCreate(importedMemory, radixMemorySize);
+        RadixIterator importedIterator = radixIterator(&imported);
+
+        if (radixImport(&imported, image, imageSize)) {
+            printf("ERROR (Import): Image was not imported!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixMatch match = radixMatchNullable(&importedIterator, cases[i].key, strlen(cases[i].key) * 8);
+
+            if (radixMatchIsEmpty(&match) || (cases[i].data && strcmp(match.data, cases[i].data) != 0)) {
+                printf("ERROR (Import): Wrong value! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+        }
+
+        // Damaged image is rejected by the checksum
+        image[imageSize - 1] ^= 1;
+
+        if (radixImport(&imported, image, imageSize) != RADIX_INVALID_ARGUMENT) {
+            printf("ERROR (Import): Damaged image was imported!\n");
+            return -1;
+        }
+
+        // Damaged image leaves the structure untouched (all checksums are verified before copying)
+        RadixMatch untouched = radixMatch(&importedIterator, cases[0].key, strlen(cases[0].key) * 8);
+
+        if (radixMatchIsEmpty(&untouched) || strcmp(untouched.data, cases[0].data) != 0) {
+            printf("ERROR (Import): Damaged image changed the structure!\n");
+            return -1;
+        }
+
+        printf("image size: %zu\tmemory usage: %zu\n", imageSize, radixMemoryUsage(&radix));
+        printf("\n");
+
+        free(importedMemory);
+        free(image);
+    }
+
+    // Show radixStreamExport, radixStreamImport functionality
+    printf("Streaming export and import:\n");
+    {
+        TestStream stream = {0};
+
+        // Small buffer - the stream is written in many blocks
+        unsigned char buffer[128];
+
+        if (radixStreamExport(&radix, streamWrite, &stream, buffer, sizeof(buffer))) {
+            printf("ERROR (Stream Export): Structure was not exported!\n");
+            return -1;
+        }
+
+        unsigned char *streamedMemory = malloc(radixMemorySize);
+
+        Radix streamed = radixCreate(streamedMemory, radixMemorySize);
+        RadixIterator streamedIterator = radixIterator(&streamed);
+
+        if (radixClear(&streamed)) {
+            printf("ERROR (Clear): Out of memory!\n");
+            return -1;
+        }
+
+        if (radixStreamImport(&streamed, streamRead, &stream, buffer, sizeof(buffer))) {
+            printf("ERROR (Stream Import): Stream was not imported!\n");
+            return -1;
+        }
+
+        size_t values = 0;
+
+        for (RadixIterator next = radixNext(&streamedIterator); !radixIteratorIsEmpty(&next); next = radixNext(&next))
+            values++;
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+            RadixMatch expected = radixMatch(&iterator, cases[i].key, strlen(cases[i].key) * 8);
+            RadixMatch match = radixMatch(&streamedIterator, cases[i].key, strlen(cases[i].key) * 8);
+
+            if (radixMatchIsEmpty(&match) != radixMatchIsEmpty(&expected) || (!radixMatchIsEmpty(&match) && strcmp(match.data, expected.data) != 0)) {
+                printf("ERROR (Stream Import): Wrong value! (key: %s)\n", cases[i].key);
+                return -1;
+            }
+        }
+
+        // Damaged stream is rejected by the checksum (and the structure is left as it was)
+        stream.memory[stream.size / 2] ^= 1;
+        stream.position = 0;
+
+        if (radixStreamImport(&streamed, streamRead, &stream, buffer, sizeof(buffer)) == RADIX_SUCCESS) {
+            printf("ERROR (Stream Import): Damaged stream was imported!\n");
+            return -1;
+        }
+
+        printf("stream size: %zu\tvalues: %zu\n", stream.size, values);
+        printf("\n");
+
+        free(streamedMemory);
+    }
+
+    // Show radixDeltaSince, radixApplyDelta functionality
+    printf("Deltas:\n");
+    {
+        // Replica starts as a copy of the structure at the checkpoint
+        unsigned char *replicaMemory = malloc(radixMemorySize);
+
+        memcpy(replicaMemory, radixMemory, radixMemoryUsage(&radix));
+
+        Radix replica = radixCreate(replicaMemory, radixMemorySize);
+        RadixIterator replicaIterator = radixIterator(&replica);
+
+        RadixCheckpoint checkpoint = radixCheckpoint(&radix);
+
+        radixInsert(&iterator, "Key-d", 5 * 8, " Value-d", 9);
+        radixInsert(&iterator, "Key-aa", 6 * 8, " Value-aa2", 11);
+        radixRemove(&iterator, "Key-b", 5 * 8);
+
+        TestStream stream = {0};
+
+        if (radixDeltaSince(&radix, &checkpoint, streamWrite, &stream)) {
+            printf("ERROR (Delta Since): Delta was not written!\n");
+            return -1;
+        }
+
+        if (radixApplyDelta(&replica, streamRead, &stream)) {
+            printf("ERROR (Apply Delta): Delta was not applied!\n");
+            return -1;
+        }
+
+        for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]) + 1; i++) {
+            unsigned char *key = i < sizeof(cases)/sizeof(cases[0]) ? cases[i].key : (unsigned char *)"Key-d";
+
+            RadixMatch expected = radixMatch(&iterator, key, strlen(key) * 8);
+            RadixMatch match = radixMatch(&replicaIterator, key, strlen(key) * 8);
+
+            if (radixMatchIsEmpty(&match) != radixMatchIsEmpty(&expected) || (!radixMatchIsEmpty(&match) && strcmp(match.data, expected.data) != 0)) {
+                printf("ERROR (Apply Delta): Wrong value! (key: %s)\n", key);
+                return -1;
+            }
+        }
+
+        // Delta continues only the state of its checkpoint
+        stream.position = 0;
+
+        if (radixApplyDelta(&replica, streamRead, &stream) != RADIX_INVALID_ARGUMENT) {
+            printf("ERROR (Apply Delta): Delta was applied twice!\n");
+            return -1;
+        }
+
+        printf("delta size: %zu\tmemory usage: %zu\n", stream.size, radixMemoryUsage(&replica));
+        printf("\n");
+
+        free(replicaMemory);
+    }
 
     free(radixMemory);
 